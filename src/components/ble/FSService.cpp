@@ -8,6 +8,7 @@ using namespace Pinetime::Controllers;
 constexpr ble_uuid16_t FSService::fsServiceUuid;
 constexpr ble_uuid128_t FSService::fsVersionUuid;
 constexpr ble_uuid128_t FSService::fsTransferUuid;
+constexpr ble_uuid128_t FSService::fsStatisticsUuid;
 
 int FSServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
   auto* fsService = static_cast<FSService*>(arg);
@@ -29,6 +30,11 @@ FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Control
                                 .flags = BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
                                 .val_handle = &transferCharacteristicHandle,
                               },
+                              {.uuid = &fsStatisticsUuid.u,
+                               .access_cb = FSServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &statisticsCharacteristicHandle},
                               {0}},
     serviceDefinition {
       {/* Device Information Service */
@@ -57,6 +63,26 @@ int FSService::OnFSServiceRequested(uint16_t connectionHandle, uint16_t attribut
   if (attributeHandle == transferCharacteristicHandle) {
     return FSCommandHandler(connectionHandle, context->om);
   }
+  if (attributeHandle == statisticsCharacteristicHandle) {
+    const auto& stats = fs.GetStatistics();
+    lfs_ssize_t usedBlocks = fs.GetFSSize();
+    StatisticsResponse resp;
+    resp.blockCount = FS::getBlockCount();
+    resp.usedBlocks = usedBlocks < 0 ? 0 : usedBlocks;
+    resp.blockCycles = FS::blockCycles;
+    resp.mountDurationMs = stats.mountDurationMs;
+    resp.open = stats.open;
+    resp.read = stats.read;
+    resp.write = stats.write;
+    resp.erase = stats.erase;
+    resp.bytesProgrammed = stats.bytesProgrammed;
+    resp.lastWindowBytesProgrammed = stats.lastWindowBytesProgrammed;
+    resp.windowBytesProgrammed = stats.windowBytesProgrammed;
+    resp.windows = stats.windows;
+    resp.formatted = stats.formatted ? 1 : 0;
+    int res = os_mbuf_append(context->om, &resp, sizeof(resp));
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
   return 0;
 }
 
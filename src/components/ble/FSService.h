@@ -29,6 +29,7 @@ namespace Pinetime {
       static constexpr uint16_t FSServiceId {0xFEBB};
       static constexpr uint16_t fsVersionId {0x0100};
       static constexpr uint16_t fsTransferId {0x0200};
+      static constexpr uint16_t fsStatisticsId {0x0300};
       uint16_t fsVersion = {0x0004};
       static constexpr uint16_t maxpathlen = 256;
       static constexpr ble_uuid16_t fsServiceUuid {
@@ -43,10 +44,15 @@ namespace Pinetime {
         .u {.type = BLE_UUID_TYPE_128},
         .value = {0x72, 0x65, 0x66, 0x73, 0x6e, 0x61, 0x72, 0x54, 0x65, 0x6c, 0x69, 0x46, 0x00, 0x02, 0xAF, 0xAD}};
 
-      struct ble_gatt_chr_def characteristicDefinition[3];
+      static constexpr ble_uuid128_t fsStatisticsUuid {
+        .u {.type = BLE_UUID_TYPE_128},
+        .value = {0x72, 0x65, 0x66, 0x73, 0x6e, 0x61, 0x72, 0x54, 0x65, 0x6c, 0x69, 0x46, 0x00, 0x03, 0xAF, 0xAD}};
+
+      struct ble_gatt_chr_def characteristicDefinition[4];
       struct ble_gatt_svc_def serviceDefinition[2];
       uint16_t versionCharacteristicHandle;
       uint16_t transferCharacteristicHandle;
+      uint16_t statisticsCharacteristicHandle;
 
       enum class commands : uint8_t {
         INVALID = 0x00,
@@ -190,6 +196,23 @@ namespace Pinetime {
         uint8_t status;
       };
 
+      using StatisticsResponse = struct __attribute__((packed)) {
+        uint32_t blockCount;
+        uint32_t usedBlocks;
+        uint32_t blockCycles;
+        uint32_t mountDurationMs;
+        FS::OperationStatistics open;
+        FS::OperationStatistics read;
+        FS::OperationStatistics write;
+        FS::OperationStatistics erase;
+        uint32_t bytesProgrammed;
+        uint32_t lastWindowBytesProgrammed;
+        uint32_t windowBytesProgrammed;
+        uint32_t windows;
+        uint8_t formatted;
+      };
+      static_assert(sizeof(FS::OperationStatistics) == 12, "The statistics of the operations must not be padded");
+
       int FSCommandHandler(uint16_t connectionHandle, os_mbuf* om);
       void prepareReadDataResp(ReadHeader* header, ReadResponse* resp);
     };
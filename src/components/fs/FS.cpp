@@ -1,12 +1,39 @@
 #include "components/fs/FS.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <algorithm>
 #include <cstring>
 #include <littlefs/lfs.h>
 #include <lvgl/lvgl.h>
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  // littlefs accepts the path without its leading slash or with repeated ones, they all name the pack
+  bool IsResourcePack(const char* path) {
+    while (*path == '/') {
+      path++;
+    }
+    return std::strcmp(path, ResourcePack::path + 1) == 0;
+  }
+
+  uint32_t ElapsedMs(TickType_t start) {
+    return (xTaskGetTickCount() - start) * 1000 / configTICK_RATE_HZ;
+  }
+
+  void RecordOperation(FS::OperationStatistics& operation, TickType_t start) {
+    uint32_t latencyMs = ElapsedMs(start);
+    operation.count++;
+    operation.totalLatencyMs += latencyMs;
+    operation.maxLatencyMs = std::max(operation.maxLatencyMs, latencyMs);
+  }
+}
+
 FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
   : flashDriver {driver},
+    readCache {driver},
+    writeBuffer {driver, readCache, blockSize},
+    resourcePack {driver, startAddress, blockSize, size / blockSize},
     lfsConfig {
       .context = this,
       .read = SectorRead,
@@ -14,14 +41,14 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
       .erase = SectorErase,
       .sync = SectorSync,
 
-      .read_size = 16,
+      .read_size = FS_LFS_READ_SIZE,
       .prog_size = 8,
       .block_size = blockSize,
       .block_count = size / blockSize,
-      .block_cycles = 1000u,
+      .block_cycles = blockCycles,
 
-      .cache_size = 16,
-      .lookahead_size = 16,
+      .cache_size = FS_LFS_CACHE_SIZE,
+      .lookahead_size = FS_LFS_LOOKAHEAD_SIZE,
 
       .name_max = 50,
       .attr_max = 50,
@@ -29,6 +56,7 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
 }
 
 void FS::Init() {
+  TickType_t start = xTaskGetTickCount();
 
   // try mount
   int err = lfs_mount(&lfs, &lfsConfig);
@@ -37,11 +65,13 @@ void FS::Init() {
   // this should only happen on the first boot
   if (err != LFS_ERR_OK) {
     lfs_format(&lfs, &lfsConfig);
+    statistics.formatted = true;
     err = lfs_mount(&lfs, &lfsConfig);
     if (err != LFS_ERR_OK) {
       return;
     }
   }
+  statistics.mountDurationMs = ElapsedMs(start);
 
 #ifndef PINETIME_IS_RECOVERY
   VerifyResource();
@@ -49,12 +79,27 @@ void FS::Init() {
 }
 
 void FS::VerifyResource() {
-  // validate the resource metadata
-  resourcesValid = true;
+  resourcesValid = resourcePack.Load(*this);
+}
+
+bool FS::IsResourceAvailable(const char* path) {
+  ResourcePack::Asset asset;
+  if (resourcePack.Find(path, asset)) {
+    return true;
+  }
+  lfs_info info;
+  return Stat(path, &info) == LFS_ERR_OK;
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
-  return lfs_file_open(&lfs, file_p, fileName, flags);
+  // The blocks of the pack change when it is written
+  if ((flags & LFS_O_WRONLY) != 0 && IsResourcePack(fileName)) {
+    resourcePack.Unload();
+  }
+  TickType_t start = xTaskGetTickCount();
+  int result = lfs_file_open(&lfs, file_p, fileName, flags);
+  RecordOperation(statistics.open, start);
+  return result;
 }
 
 int FS::FileClose(lfs_file_t* file_p) {
@@ -62,11 +107,17 @@ int FS::FileClose(lfs_file_t* file_p) {
 }
 
 int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
-  return lfs_file_read(&lfs, file_p, buff, size);
+  TickType_t start = xTaskGetTickCount();
+  int result = lfs_file_read(&lfs, file_p, buff, size);
+  RecordOperation(statistics.read, start);
+  return result;
 }
 
 int FS::FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size) {
-  return lfs_file_write(&lfs, file_p, buff, size);
+  TickType_t start = xTaskGetTickCount();
+  int result = lfs_file_write(&lfs, file_p, buff, size);
+  RecordOperation(statistics.write, start);
+  return result;
 }
 
 int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
@@ -74,6 +125,9 @@ int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
 }
 
 int FS::FileDelete(const char* fileName) {
+  if (IsResourcePack(fileName)) {
+    resourcePack.Unload();
+  }
   return lfs_remove(&lfs, fileName);
 }
 
@@ -98,6 +152,9 @@ int FS::DirCreate(const char* path) {
 }
 
 int FS::Rename(const char* oldPath, const char* newPath) {
+  if (IsResourcePack(oldPath) || IsResourcePack(newPath)) {
+    resourcePack.Unload();
+  }
   return lfs_rename(&lfs, oldPath, newPath);
 }
 
@@ -114,27 +171,40 @@ lfs_ssize_t FS::GetFSSize() {
     ----------- Interface between littlefs and SpiNorFlash -----------
 
 */
-int FS::SectorSync(const struct lfs_config* /*c*/) {
-  return 0;
+int FS::SectorSync(const struct lfs_config* c) {
+  Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  return lfs.writeBuffer.Flush() ? 0 : -1;
 }
 
 int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize);
+  TickType_t start = xTaskGetTickCount();
+  lfs.writeBuffer.Discard(address, blockSize);
+  lfs.readCache.Invalidate(address, blockSize);
   lfs.flashDriver.SectorErase(address);
+  RecordOperation(lfs.statistics.erase, start);
+
+  if (lfs.statistics.erase.count % blockCycles == 0) {
+    lfs.statistics.lastWindowBytesProgrammed = lfs.statistics.windowBytesProgrammed;
+    lfs.statistics.windowBytesProgrammed = 0;
+    lfs.statistics.windows++;
+  }
   return lfs.flashDriver.EraseFailed() ? -1 : 0;
 }
 
 int FS::SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Write(address, (uint8_t*) buffer, size);
-  return lfs.flashDriver.ProgramFailed() ? -1 : 0;
+  lfs.statistics.bytesProgrammed += size;
+  lfs.statistics.windowBytesProgrammed += size;
+  return lfs.writeBuffer.Program(address, static_cast<const uint8_t*>(buffer), size) ? 0 : -1;
 }
 
 int FS::SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Read(address, static_cast<uint8_t*>(buffer), size);
+  lfs.readCache.Read(address, static_cast<uint8_t*>(buffer), size);
+  lfs.writeBuffer.ApplyTo(address, static_cast<uint8_t*>(buffer), size);
   return 0;
 }
@@ -2,12 +2,55 @@
 
 #include <cstdint>
 #include "drivers/SpiNorFlash.h"
+#include "components/fs/FlashReadCache.h"
+#include "components/fs/FlashWriteBuffer.h"
+#include "components/fs/ResourcePack.h"
 #include <littlefs/lfs.h>
 
+// Sizes of the littlefs buffers, can be changed per build (-DFS_LFS_CACHE_SIZE=64).
+// The cache size must be a multiple of the read size (and of the program size, 8) and divide the block size.
+// The lookahead size must be a multiple of 8.
+#ifndef FS_LFS_READ_SIZE
+  #define FS_LFS_READ_SIZE 16
+#endif
+#ifndef FS_LFS_CACHE_SIZE
+  #define FS_LFS_CACHE_SIZE 16
+#endif
+#ifndef FS_LFS_LOOKAHEAD_SIZE
+  #define FS_LFS_LOOKAHEAD_SIZE 16
+#endif
+
 namespace Pinetime {
   namespace Controllers {
     class FS {
     public:
+      // Erases of a metadata block before littlefs moves it to another block
+      static constexpr uint32_t blockCycles = 1000;
+
+      // Latencies are measured with the tick count of FreeRTOS: operations shorter than a tick count for 0 ms
+      struct OperationStatistics {
+        uint32_t count = 0;
+        uint32_t totalLatencyMs = 0;
+        uint32_t maxLatencyMs = 0;
+      };
+
+      struct Statistics {
+        // Duration of the mount by Init(), including the format if the filesystem could not be mounted
+        uint32_t mountDurationMs = 0;
+        bool formatted = false;
+        OperationStatistics open;
+        OperationStatistics read;
+        OperationStatistics write;
+        // Blocks erased by littlefs
+        OperationStatistics erase;
+        uint32_t bytesProgrammed = 0;
+        // Bytes programmed during the last blockCycles erases, at most blockCycles * blockSize when littlefs only
+        // erases blocks to fill them. Low values mean that blocks are erased (and worn) for small writes.
+        uint32_t lastWindowBytesProgrammed = 0;
+        uint32_t windowBytesProgrammed = 0;
+        uint32_t windows = 0;
+      };
+
       FS(Pinetime::Drivers::SpiNorFlash&);
 
       void Init();
@@ -29,7 +72,10 @@ namespace Pinetime {
       lfs_ssize_t GetFSSize();
       int Rename(const char* oldPath, const char* newPath);
       int Stat(const char* path, lfs_info* info);
+      // Load the resource pack and validate its index
       void VerifyResource();
+      // True if the resource is in the loaded pack, or installed as a separate file
+      bool IsResourceAvailable(const char* path);
 
       static size_t getSize() {
         return size;
@@ -39,8 +85,43 @@ namespace Pinetime {
         return blockSize;
       }
 
+      static size_t getBlockCount() {
+        return size / blockSize;
+      }
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      const FlashReadCache::Statistics& GetReadCacheStatistics() const {
+        return readCache.GetStatistics();
+      }
+
+      const FlashWriteBuffer::Statistics& GetWriteBufferStatistics() const {
+        return writeBuffer.GetStatistics();
+      }
+
+      const Pinetime::Drivers::SpiNorFlash::EraseStatistics& GetEraseStatistics() const {
+        return flashDriver.GetEraseStatistics();
+      }
+
+      TickType_t GetFlashTicksInPowerState(Pinetime::Drivers::SpiNorFlash::PowerStates state) const {
+        return flashDriver.GetTicksInPowerState(state);
+      }
+
+      uint32_t GetWriteAmplificationPercent() const {
+        return writeBuffer.WriteAmplificationPercent();
+      }
+
+      ResourcePack& GetResourcePack() {
+        return resourcePack;
+      }
+
     private:
       Pinetime::Drivers::SpiNorFlash& flashDriver;
+      FlashReadCache readCache;
+      FlashWriteBuffer writeBuffer;
+      ResourcePack resourcePack;
 
       /*
        * External Flash MAP (4 MBytes)
@@ -67,8 +148,12 @@ namespace Pinetime {
       static constexpr size_t startAddress = 0x0B4000;
       static constexpr size_t size = 0x34C000;
       static constexpr size_t blockSize = 4096;
+      static_assert(FS_LFS_CACHE_SIZE % FS_LFS_READ_SIZE == 0 && FS_LFS_CACHE_SIZE % 8 == 0, "Invalid littlefs cache size");
+      static_assert(blockSize % FS_LFS_CACHE_SIZE == 0, "The littlefs cache size must divide the block size");
+      static_assert(FS_LFS_LOOKAHEAD_SIZE % 8 == 0, "The littlefs lookahead size must be a multiple of 8");
 
       bool resourcesValid = false;
+      Statistics statistics;
       const struct lfs_config lfsConfig;
 
       lfs_t lfs;
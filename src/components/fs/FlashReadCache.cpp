@@ -0,0 +1,93 @@
+#include "components/fs/FlashReadCache.h"
+#include <cstring>
+
+using namespace Pinetime::Controllers;
+
+FlashReadCache::FlashReadCache(Pinetime::Drivers::SpiNorFlash& flashDriver) : flashDriver {flashDriver} {
+}
+
+void FlashReadCache::Read(uint32_t address, uint8_t* buffer, size_t size) {
+  if (size >= pageSize) {
+    statistics.uncached++;
+    flashDriver.Read(address, buffer, size);
+    return;
+  }
+
+  // Page loaded with the previous one
+  Page* nextPage = nullptr;
+  while (size > 0) {
+    uint32_t pageAddress = address & ~(pageSize - 1);
+    uint32_t offset = address - pageAddress;
+    size_t length = pageSize - offset;
+    if (length > size) {
+      length = size;
+    }
+
+    Page* page = nextPage;
+    nextPage = nullptr;
+    if (page != nullptr) {
+      statistics.misses++;
+    } else if ((page = Find(pageAddress)) != nullptr) {
+      statistics.hits++;
+      statistics.bytesSaved += length;
+    } else {
+      statistics.misses++;
+      // A small read spans two pages at most: when the next one is missing too, read both in one transaction
+      uint32_t nextPageAddress = pageAddress + pageSize;
+      if (nbPages > 1 && length < size && Find(nextPageAddress) == nullptr) {
+        page = Evict(pageAddress);
+        nextPage = Evict(nextPageAddress);
+        const Pinetime::Drivers::SpiNorFlash::ReadRegion regions[] = {{pageAddress, page->data, pageSize},
+                                                                      {nextPageAddress, nextPage->data, pageSize}};
+        flashDriver.ReadRegions(regions, 2);
+      } else {
+        page = Evict(pageAddress);
+        flashDriver.Read(pageAddress, page->data, pageSize);
+      }
+    }
+    page->lastUse = ++useCounter;
+    std::memcpy(buffer, &page->data[offset], length);
+
+    address += length;
+    buffer += length;
+    size -= length;
+  }
+}
+
+void FlashReadCache::Invalidate(uint32_t address, size_t size) {
+  uint32_t firstPage = address & ~(pageSize - 1);
+  uint32_t end = address + size;
+  for (auto& page : pages) {
+    if (page.address != invalidAddress && page.address >= firstPage && page.address < end) {
+      page.address = invalidAddress;
+      statistics.invalidations++;
+    }
+  }
+}
+
+FlashReadCache::Page* FlashReadCache::Find(uint32_t pageAddress) {
+  for (auto& page : pages) {
+    if (page.address == pageAddress) {
+      return &page;
+    }
+  }
+  return nullptr;
+}
+
+// Assign the least recently used entry to the page, invalid entries having never been used.
+// The entry is marked as used, so that evicting another page does not return it again.
+FlashReadCache::Page* FlashReadCache::Evict(uint32_t pageAddress) {
+  Page* leastRecentlyUsed = &pages[0];
+  for (auto& page : pages) {
+    if (page.address == invalidAddress) {
+      leastRecentlyUsed = &page;
+      break;
+    }
+    if (page.lastUse < leastRecentlyUsed->lastUse) {
+      leastRecentlyUsed = &page;
+    }
+  }
+  leastRecentlyUsed->address = pageAddress;
+  leastRecentlyUsed->lastUse = ++useCounter;
+  return leastRecentlyUsed;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "drivers/SpiNorFlash.h"
+
+// Number of flash pages kept in RAM by FlashReadCache, can be changed per build (-DFS_READ_CACHE_PAGES=8)
+#ifndef FS_READ_CACHE_PAGES
+  #define FS_READ_CACHE_PAGES 4
+#endif
+
+namespace Pinetime {
+  namespace Controllers {
+    /* Keeps the most recently read pages of the external flash in RAM, so that the small reads of littlefs
+     * (directory entries, file metadata, ...) do not go to the flash each time the same structures are looked up.
+     *
+     * Only small reads are cached: large reads (file content read directly into the buffer of the caller) would
+     * evict the metadata pages and are rarely read again soon. A read across two pages which are both missing loads them
+ * with a single batched read. Pages are invalidated when they are programmed or erased.
+     */
+    class FlashReadCache {
+    public:
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        // Bytes copied from RAM instead of being read from the flash
+        uint32_t bytesSaved = 0;
+        // Large reads sent to the flash directly
+        uint32_t uncached = 0;
+        uint32_t invalidations = 0;
+      };
+
+      static constexpr size_t pageSize = 256;
+      static constexpr size_t nbPages = FS_READ_CACHE_PAGES;
+
+      explicit FlashReadCache(Pinetime::Drivers::SpiNorFlash& flashDriver);
+
+      FlashReadCache(const FlashReadCache&) = delete;
+      FlashReadCache& operator=(const FlashReadCache&) = delete;
+      FlashReadCache(FlashReadCache&&) = delete;
+      FlashReadCache& operator=(FlashReadCache&&) = delete;
+
+      void Read(uint32_t address, uint8_t* buffer, size_t size);
+      // Drop the cached pages overlapping the given range, to be called before the flash is programmed or erased
+      void Invalidate(uint32_t address, size_t size);
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
+    private:
+      static_assert(nbPages > 0, "FS_READ_CACHE_PAGES must be at least 1");
+      static constexpr uint32_t invalidAddress = UINT32_MAX;
+
+      struct Page {
+        uint32_t address = invalidAddress;
+        uint32_t lastUse = 0;
+        uint8_t data[pageSize];
+      };
+
+      Page* Find(uint32_t pageAddress);
+      Page* Evict(uint32_t pageAddress);
+
+      Pinetime::Drivers::SpiNorFlash& flashDriver;
+      Page pages[nbPages];
+      uint32_t useCounter = 0;
+      Statistics statistics;
+    };
+  }
+}
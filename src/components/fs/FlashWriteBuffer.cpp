@@ -0,0 +1,106 @@
+#include "components/fs/FlashWriteBuffer.h"
+#include <cstring>
+
+using namespace Pinetime::Controllers;
+
+FlashWriteBuffer::FlashWriteBuffer(Pinetime::Drivers::SpiNorFlash& flashDriver, FlashReadCache& readCache, uint32_t blockSize)
+  : flashDriver {flashDriver}, readCache {readCache}, blockSize {blockSize} {
+}
+
+bool FlashWriteBuffer::Program(uint32_t address, const uint8_t* buffer, size_t size) {
+  statistics.programs++;
+  statistics.bytesRequested += size;
+
+  bool success = true;
+  while (size > 0) {
+    uint32_t page = address & ~(pageSize - 1);
+    size_t offset = address - page;
+    size_t length = pageSize - offset;
+    if (length > size) {
+      length = size;
+    }
+
+    if (page != pageAddress) {
+      bool isSameBlock = pageAddress != invalidAddress && pageAddress / blockSize == page / blockSize;
+      if (!ProgramPage()) {
+        if (isSameBlock) {
+          success = false;
+        } else {
+          hasDeferredFailure = true;
+        }
+      }
+      pageAddress = page;
+      std::memset(data, 0xff, pageSize);
+      start = offset;
+      end = offset;
+    }
+    // Programming can only clear bits, programming the same byte twice results in the AND of both values
+    for (size_t i = 0; i < length; i++) {
+      data[offset + i] &= buffer[i];
+    }
+    if (offset < start) {
+      start = offset;
+    }
+    if (offset + length > end) {
+      end = offset + length;
+    }
+    if (end == pageSize) {
+      success = ProgramPage() && success;
+    }
+
+    address += length;
+    buffer += length;
+    size -= length;
+  }
+  return success;
+}
+
+bool FlashWriteBuffer::Flush() {
+  bool success = ProgramPage() && !hasDeferredFailure;
+  hasDeferredFailure = false;
+  return success;
+}
+
+bool FlashWriteBuffer::ProgramPage() {
+  if (pageAddress == invalidAddress) {
+    return true;
+  }
+  uint32_t address = pageAddress + start;
+  size_t size = end - start;
+  pageAddress = invalidAddress;
+
+  readCache.Invalidate(address, size);
+  flashDriver.Write(address, &data[start], size);
+  statistics.flashWrites++;
+  statistics.bytesWritten += size;
+  if (flashDriver.ProgramFailed()) {
+    statistics.failures++;
+    statistics.lastFailedAddress = address;
+    return false;
+  }
+  return true;
+}
+
+void FlashWriteBuffer::ApplyTo(uint32_t address, uint8_t* buffer, size_t size) const {
+  if (pageAddress == invalidAddress || address >= pageAddress + pageSize || address + size <= pageAddress) {
+    return;
+  }
+  uint32_t first = (address > pageAddress + start) ? address : pageAddress + start;
+  uint32_t last = (address + size < pageAddress + end) ? address + size : pageAddress + end;
+  for (uint32_t i = first; i < last; i++) {
+    buffer[i - address] &= data[i - pageAddress];
+  }
+}
+
+void FlashWriteBuffer::Discard(uint32_t address, size_t size) {
+  if (pageAddress != invalidAddress && pageAddress >= address && pageAddress < address + size) {
+    pageAddress = invalidAddress;
+  }
+}
+
+uint32_t FlashWriteBuffer::WriteAmplificationPercent() const {
+  if (statistics.bytesRequested == 0) {
+    return 0;
+  }
+  return static_cast<uint64_t>(statistics.bytesWritten) * 100 / statistics.bytesRequested;
+}
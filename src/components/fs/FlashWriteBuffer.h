@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "drivers/SpiNorFlash.h"
+#include "components/fs/FlashReadCache.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    /* Gathers the small programs of littlefs into a single page program of the external flash. Each program of the
+     * flash costs a write enable and busy polling, whatever its size.
+     *
+     * The buffered page is programmed when a program targets another page, when the end of the page is reached, and
+     * when littlefs syncs. Bytes which were not programmed are left to 0xff, which does not change the content of the
+     * flash. Reads of the buffered page see the buffered programs (littlefs reads back each program to validate it),
+     * so that they do not force the page to be programmed early.
+     *
+     * A failed program of the buffered page is reported by the Program() call which flushed it when that call targets
+     * the same block. Otherwise the failure belongs to a block littlefs has finished programming: it is reported by the
+     * next Flush(), which littlefs calls to sync that block, and the address is kept in the statistics.
+     */
+    class FlashWriteBuffer {
+    public:
+      struct Statistics {
+        // Programs requested by littlefs, and their size
+        uint32_t programs = 0;
+        uint32_t bytesRequested = 0;
+        // Programs of the flash, and their size (including the unprogrammed bytes between the requested ones)
+        uint32_t flashWrites = 0;
+        uint32_t bytesWritten = 0;
+        uint32_t failures = 0;
+        uint32_t lastFailedAddress = 0;
+      };
+
+      static constexpr size_t pageSize = 256;
+
+      FlashWriteBuffer(Pinetime::Drivers::SpiNorFlash& flashDriver, FlashReadCache& readCache, uint32_t blockSize);
+
+      FlashWriteBuffer(const FlashWriteBuffer&) = delete;
+      FlashWriteBuffer& operator=(const FlashWriteBuffer&) = delete;
+      FlashWriteBuffer(FlashWriteBuffer&&) = delete;
+      FlashWriteBuffer& operator=(FlashWriteBuffer&&) = delete;
+
+      // Return false if a program of the flash failed in the block of address
+      bool Program(uint32_t address, const uint8_t* buffer, size_t size);
+      // Return false if the program of the buffered page, or a program of a block left since the last Flush(), failed
+      bool Flush();
+      // Apply the buffered programs to data read from the flash at address
+      void ApplyTo(uint32_t address, uint8_t* buffer, size_t size) const;
+      // Drop the buffered page if it is in the range, to be called before the range is erased
+      void Discard(uint32_t address, size_t size);
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      // Bytes written to the flash per 100 bytes requested by littlefs
+      uint32_t WriteAmplificationPercent() const;
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
+    private:
+      static constexpr uint32_t invalidAddress = UINT32_MAX;
+
+      bool ProgramPage();
+
+      Pinetime::Drivers::SpiNorFlash& flashDriver;
+      FlashReadCache& readCache;
+      const uint32_t blockSize;
+      // A program failed in a block other than the one being programmed, to be reported by Flush()
+      bool hasDeferredFailure = false;
+
+      uint32_t pageAddress = invalidAddress;
+      // Range of the page holding programmed bytes
+      size_t start = 0;
+      size_t end = 0;
+      uint8_t data[pageSize];
+      Statistics statistics;
+    };
+  }
+}
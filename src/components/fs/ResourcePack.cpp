@@ -0,0 +1,168 @@
+#include "components/fs/ResourcePack.h"
+#include <algorithm>
+#include <cstring>
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  constexpr char magic[4] = {'I', 'R', 'P', 'K'};
+
+  // CRC-32 (IEEE 802.3, as zlib.crc32), computed bit by bit: the index is only checked at boot
+  uint32_t Crc32(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < size; i++) {
+      crc ^= data[i];
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+      }
+    }
+    return ~crc;
+  }
+
+  // Paths of the F: drive of lvgl arrive without their leading '/'
+  static_assert(ResourcePack::Id("images/pine_small.bin") == ResourcePack::Id("/images/pine_small.bin"),
+                "The id of an asset must not depend on the leading '/' of its path");
+  static_assert(ResourcePack::Id("//fonts/teko.bin") == ResourcePack::Id("/fonts/teko.bin"),
+                "The id of an asset must not depend on the leading '/' of its path");
+}
+
+ResourcePack::ResourcePack(Pinetime::Drivers::SpiNorFlash& flashDriver, size_t startAddress, size_t blockSize, size_t blockCount)
+  : flashDriver {flashDriver}, startAddress {startAddress}, blockSize {blockSize}, blockCount {blockCount} {
+}
+
+bool ResourcePack::Load(FS& filesystem) {
+  Unload();
+
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+  bool loaded = MapBlocks(file) && LoadIndex();
+  filesystem.FileClose(&file);
+
+  isLoaded = loaded;
+  return isLoaded;
+}
+
+void ResourcePack::Unload() {
+  isLoaded = false;
+  fileSize = 0;
+  nbAssets = 0;
+  nbBlocks = 0;
+}
+
+bool ResourcePack::Find(uint32_t id, Asset& asset) const {
+  if (!isLoaded) {
+    return false;
+  }
+  const IndexEntry* end = index + nbAssets;
+  const IndexEntry* entry = std::lower_bound(index, end, id, [](const IndexEntry& e, uint32_t value) {
+    return e.id < value;
+  });
+  if (entry == end || entry->id != id) {
+    return false;
+  }
+  asset.offset = entry->offset;
+  asset.size = entry->size;
+  return true;
+}
+
+uint32_t ResourcePack::Read(const Asset& asset, uint32_t position, uint8_t* buffer, uint32_t size) {
+  if (!isLoaded || position >= asset.size) {
+    return 0;
+  }
+  if (size > asset.size - position) {
+    size = asset.size - position;
+  }
+  ReadFile(dataOffset + asset.offset + position, buffer, size);
+  return size;
+}
+
+// Record the flash block of each block of the file. littlefs stores files as a backward linked list (CTZ skip-list):
+// the file points to its last block, and the first word of each block points to the previous one.
+bool ResourcePack::MapBlocks(const lfs_file_t& file) {
+  // Small files are stored inline in the metadata of their directory
+  if ((file.flags & LFS_F_INLINE) != 0 || file.ctz.size == 0) {
+    return false;
+  }
+
+  fileSize = file.ctz.size;
+  uint32_t lastOffset = fileSize - 1;
+  uint32_t last = BlockIndex(lastOffset);
+  if (last >= maxBlocks) {
+    return false;
+  }
+
+  lfs_block_t block = file.ctz.head;
+  for (uint32_t i = last;; i--) {
+    if (block >= blockCount) {
+      return false;
+    }
+    blocks[i] = static_cast<uint16_t>(block);
+    if (i == 0) {
+      break;
+    }
+    uint32_t previous;
+    flashDriver.Read(startAddress + block * blockSize, reinterpret_cast<uint8_t*>(&previous), sizeof(previous));
+    block = previous;
+  }
+  nbBlocks = last + 1;
+  return true;
+}
+
+bool ResourcePack::LoadIndex() {
+  Header header;
+  if (fileSize < sizeof(header)) {
+    return false;
+  }
+  ReadFile(0, reinterpret_cast<uint8_t*>(&header), sizeof(header));
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version || header.nbAssets > maxAssets) {
+    return false;
+  }
+
+  uint32_t indexSize = header.nbAssets * sizeof(IndexEntry);
+  dataOffset = sizeof(header) + indexSize;
+  if (dataOffset > fileSize || header.dataSize > fileSize - dataOffset) {
+    return false;
+  }
+
+  ReadFile(sizeof(header), reinterpret_cast<uint8_t*>(index), indexSize);
+  if (Crc32(reinterpret_cast<const uint8_t*>(index), indexSize) != header.indexCrc) {
+    return false;
+  }
+  for (uint16_t i = 0; i < header.nbAssets; i++) {
+    if ((i > 0 && index[i].id <= index[i - 1].id) || index[i].offset > header.dataSize ||
+        index[i].size > header.dataSize - index[i].offset) {
+      return false;
+    }
+  }
+
+  nbAssets = header.nbAssets;
+  return true;
+}
+
+// Block of the file containing the byte at offset, offset is updated to the position of that byte in the block.
+// Same computation as lfs_ctz_index() in littlefs: block n starts with ctz(n) + 1 pointers (none for block 0).
+uint32_t ResourcePack::BlockIndex(uint32_t& offset) const {
+  uint32_t dataPerBlock = blockSize - 2 * sizeof(uint32_t);
+  uint32_t i = offset / dataPerBlock;
+  if (i == 0) {
+    return 0;
+  }
+  i = (offset - sizeof(uint32_t) * (__builtin_popcount(i - 1) + 2)) / dataPerBlock;
+  offset = offset - dataPerBlock * i - sizeof(uint32_t) * __builtin_popcount(i);
+  return i;
+}
+
+void ResourcePack::ReadFile(uint32_t position, uint8_t* buffer, uint32_t size) {
+  while (size > 0) {
+    uint32_t offset = position;
+    uint32_t i = BlockIndex(offset);
+    uint32_t length = std::min<uint32_t>(size, blockSize - offset);
+    flashDriver.Read(startAddress + blocks[i] * blockSize + offset, buffer, length);
+    position += length;
+    buffer += length;
+    size -= length;
+  }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <littlefs/lfs.h>
+#include "drivers/SpiNorFlash.h"
+
+// Limits of the resource pack, can be changed per build (-DRESOURCE_PACK_MAX_BLOCKS=256).
+// Each asset costs 12 bytes of RAM and each block of the pack file (4 KB) 2 bytes.
+#ifndef RESOURCE_PACK_MAX_ASSETS
+  #define RESOURCE_PACK_MAX_ASSETS 16
+#endif
+#ifndef RESOURCE_PACK_MAX_BLOCKS
+  #define RESOURCE_PACK_MAX_BLOCKS 128
+#endif
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+
+    /* Read-only pack of the external resources (fonts, images), installed as a single file by the companion app.
+     * It is built by src/resources/generate-package.py (--pack). Layout, little endian:
+     *
+     *   Header  magic "IRPK", version (uint16), number of assets (uint16), CRC32 of the index, size of the data
+     *   Index   one entry per asset, sorted by id: id, offset in the data, size
+     *   Data    content of the assets, each one aligned on 4 bytes
+     *
+     * The id of an asset is the FNV-1a hash of its path in the filesystem ("/fonts/teko.bin"), see Id(). The path is
+     * hashed with a single leading '/', so that the paths given by lvgl without it ("fonts/teko.bin") have the same id.
+     *
+     * The index is validated once at boot. The blocks of the pack file are located at the same time, by walking the
+     * block list of littlefs once, so that assets are then read straight from the flash with SpiNorFlash::Read()
+     * instead of going through the path lookup and the block list of littlefs on each open and seek.
+     * The pack is unloaded when its file is written, renamed or deleted.
+     */
+    class ResourcePack {
+    public:
+      struct Asset {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+      };
+
+      static constexpr const char* path = "/resources.pak";
+
+      ResourcePack(Pinetime::Drivers::SpiNorFlash& flashDriver, size_t startAddress, size_t blockSize, size_t blockCount);
+
+      ResourcePack(const ResourcePack&) = delete;
+      ResourcePack& operator=(const ResourcePack&) = delete;
+      ResourcePack(ResourcePack&&) = delete;
+      ResourcePack& operator=(ResourcePack&&) = delete;
+
+      // Locate the pack file and validate its index. Returns false if there is no pack or if it is invalid.
+      bool Load(FS& filesystem);
+      void Unload();
+
+      bool IsLoaded() const {
+        return isLoaded;
+      }
+
+      uint16_t NbAssets() const {
+        return isLoaded ? nbAssets : 0;
+      }
+
+      bool Find(uint32_t id, Asset& asset) const;
+
+      bool Find(const char* assetPath, Asset& asset) const {
+        return Find(Id(assetPath), asset);
+      }
+
+      // Read up to size bytes of the asset from position. Returns the number of bytes read.
+      uint32_t Read(const Asset& asset, uint32_t position, uint8_t* buffer, uint32_t size);
+
+      static constexpr uint32_t Id(const char* assetPath) {
+        while (*assetPath == '/') {
+          assetPath++;
+        }
+        uint32_t hash = (2166136261u ^ static_cast<uint8_t>('/')) * 16777619u;
+        while (*assetPath != '\0') {
+          hash = (hash ^ static_cast<uint8_t>(*assetPath++)) * 16777619u;
+        }
+        return hash;
+      }
+
+    private:
+      struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t nbAssets;
+        uint32_t indexCrc;
+        uint32_t dataSize;
+      };
+
+      struct IndexEntry {
+        uint32_t id;
+        uint32_t offset;
+        uint32_t size;
+      };
+
+      static_assert(sizeof(Header) == 16, "The header of the pack must not be padded");
+      static_assert(sizeof(IndexEntry) == 12, "The index entries of the pack must not be padded");
+
+      static constexpr uint16_t version = 1;
+      static constexpr uint16_t maxAssets = RESOURCE_PACK_MAX_ASSETS;
+      static constexpr uint16_t maxBlocks = RESOURCE_PACK_MAX_BLOCKS;
+
+      bool MapBlocks(const lfs_file_t& file);
+      bool LoadIndex();
+      uint32_t BlockIndex(uint32_t& offset) const;
+      void ReadFile(uint32_t position, uint8_t* buffer, uint32_t size);
+
+      Pinetime::Drivers::SpiNorFlash& flashDriver;
+      const size_t startAddress;
+      const size_t blockSize;
+      const size_t blockCount;
+
+      bool isLoaded = false;
+      uint32_t fileSize = 0;
+      uint32_t dataOffset = 0;
+      uint16_t nbAssets = 0;
+      uint16_t nbBlocks = 0;
+      IndexEntry index[maxAssets];
+      uint16_t blocks[maxBlocks];
+    };
+  }
+}
@@ -0,0 +1,466 @@
+#include "components/fs/TimeSeriesLog.h"
+#include <cstdio>
+#include <cstring>
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  constexpr char magic[4] = {'I', 'T', 'S', 'L'};
+  constexpr char trailerMagic[4] = {'I', 'T', 'S', 'E'};
+  // Directory, separator and the name of a segment ("7" or "tmp")
+  constexpr size_t maxPathLength = 32;
+}
+
+TimeSeriesLog::TimeSeriesLog(FS& filesystem, const char* directory, Aggregation aggregation)
+  : filesystem {filesystem}, directory {directory}, aggregation {aggregation} {
+}
+
+void TimeSeriesLog::Init() {
+  if (std::strlen(directory) > maxDirectoryLength) {
+    return;
+  }
+
+  // Create the parent directories, DirCreate() fails without side effect when they exist
+  char path[maxPathLength];
+  for (const char* separator = std::strchr(directory + 1, '/'); separator != nullptr; separator = std::strchr(separator + 1, '/')) {
+    size_t length = separator - directory;
+    std::memcpy(path, directory, length);
+    path[length] = '\0';
+    filesystem.DirCreate(path);
+  }
+  filesystem.DirCreate(directory);
+
+  // Left by a compaction which did not complete
+  SegmentPath(path, noSegment);
+  filesystem.FileDelete(path);
+
+  // New segments must not reuse the sequence of a merged segment, they would be taken for its source
+  lastSequence = 0;
+  for (uint8_t slot = 0; slot < maxSegments; slot++) {
+    if (LoadSegment(slot) && segments[slot].lastSourceSequence > lastSequence) {
+      lastSequence = segments[slot].lastSourceSequence;
+    }
+  }
+  DropMergedSources();
+
+  // Keep writing to the newest segment, unless it was sealed
+  activeSegment = noSegment;
+  uint8_t newest = noSegment;
+  for (uint8_t slot = NextSegment(0); slot != noSegment; slot = NextSegment(segments[slot].sequence)) {
+    newest = slot;
+  }
+  if (newest != noSegment && !segments[newest].isSealed && segments[newest].nbRecords < recordsPerSegment) {
+    activeSegment = newest;
+  }
+}
+
+void TimeSeriesLog::Append(uint32_t timestamp, int32_t value) {
+  statistics.appends++;
+  if (nbBatchRecords == batchRecords) {
+    statistics.droppedRecords++;
+    nbBatchRecords--;
+    std::memmove(batch, &batch[1], nbBatchRecords * sizeof(Record));
+  }
+  batch[nbBatchRecords++] = {timestamp, value};
+}
+
+bool TimeSeriesLog::Flush() {
+  if (nbBatchRecords == 0) {
+    return true;
+  }
+  statistics.flushes++;
+
+  uint8_t written = 0;
+  while (written < nbBatchRecords) {
+    // Records are appended to the active segment as long as it is not full and stays sorted (the time may be set back)
+    uint32_t firstTimestamp = batch[written].timestamp;
+    if (activeSegment == noSegment || segments[activeSegment].nbRecords == recordsPerSegment ||
+        firstTimestamp < (segments[activeSegment].nbRecords > 0 ? segments[activeSegment].lastTimestamp
+                                                                 : segments[activeSegment].firstTimestamp)) {
+      if (!StartSegment(firstTimestamp)) {
+        break;
+      }
+    }
+
+    Segment& segment = segments[activeSegment];
+    uint8_t count = 0;
+    uint32_t lastTimestamp = firstTimestamp;
+    while (written + count < nbBatchRecords && segment.nbRecords + count < recordsPerSegment &&
+           batch[written + count].timestamp >= lastTimestamp) {
+      lastTimestamp = batch[written + count].timestamp;
+      count++;
+    }
+
+    char path[maxPathLength];
+    SegmentPath(path, activeSegment);
+    lfs_file_t file;
+    if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_APPEND) != LFS_ERR_OK) {
+      break;
+    }
+    int size = count * sizeof(Record);
+    bool isWritten = filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&batch[written]), size) == size;
+    filesystem.FileClose(&file);
+    if (!isWritten) {
+      // The file may hold a part of the records
+      LoadSegment(activeSegment);
+      break;
+    }
+
+    segment.nbRecords += count;
+    segment.lastTimestamp = lastTimestamp;
+    statistics.recordsWritten += count;
+    written += count;
+  }
+
+  // Keep the records which could not be written for the next flush
+  nbBatchRecords -= written;
+  std::memmove(batch, &batch[written], nbBatchRecords * sizeof(Record));
+  return nbBatchRecords == 0;
+}
+
+size_t TimeSeriesLog::Query(uint32_t from, uint32_t to, Record* records, size_t maxRecords) {
+  size_t count = 0;
+  for (uint8_t slot = NextSegment(0); slot != noSegment && count < maxRecords; slot = NextSegment(segments[slot].sequence)) {
+    const Segment& segment = segments[slot];
+    if (segment.nbRecords > 0 && segment.lastTimestamp >= from && segment.firstTimestamp <= to) {
+      count += QuerySegment(slot, from, to, &records[count], maxRecords - count);
+    }
+  }
+
+  for (uint8_t i = 0; i < nbBatchRecords && count < maxRecords; i++) {
+    if (batch[i].timestamp >= from && batch[i].timestamp <= to) {
+      records[count++] = batch[i];
+    }
+  }
+  return count;
+}
+
+void TimeSeriesLog::SegmentPath(char* path, uint8_t slot) const {
+  if (slot == noSegment) {
+    std::snprintf(path, maxPathLength, "%s/tmp", directory);
+  } else {
+    std::snprintf(path, maxPathLength, "%s/%u", directory, slot);
+  }
+}
+
+bool TimeSeriesLog::LoadSegment(uint8_t slot) {
+  Segment& segment = segments[slot];
+  segment = {};
+
+  char path[maxPathLength];
+  SegmentPath(path, slot);
+  lfs_info info;
+  if (filesystem.Stat(path, &info) != LFS_ERR_OK || info.size < sizeof(Header)) {
+    return false;
+  }
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+
+  Header header;
+  bool isValid = filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+                 std::memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == version && header.sequence != 0 &&
+                 header.lastSourceSequence >= header.sequence;
+  uint32_t dataSize = info.size - sizeof(Header);
+  if (isValid && dataSize % sizeof(Record) == sizeof(Trailer) % sizeof(Record)) {
+    // Sealed segment, the trailer holds its time range
+    Trailer trailer;
+    isValid = dataSize >= sizeof(Trailer) && filesystem.FileSeek(&file, info.size - sizeof(Trailer)) >= 0 &&
+              filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(&trailer), sizeof(trailer)) == sizeof(trailer) &&
+              std::memcmp(trailer.magic, trailerMagic, sizeof(trailerMagic)) == 0 && trailer.nbRecords <= recordsPerSegment &&
+              trailer.nbRecords * sizeof(Record) + sizeof(Trailer) == dataSize;
+    segment.nbRecords = trailer.nbRecords;
+    segment.lastTimestamp = trailer.lastTimestamp;
+    segment.isSealed = true;
+  } else if (isValid) {
+    // Segment being written, its records are counted from the size of the file
+    uint32_t nbRecords = dataSize / sizeof(Record);
+    isValid = nbRecords <= recordsPerSegment;
+    segment.nbRecords = nbRecords;
+    segment.lastTimestamp = header.firstTimestamp;
+    Record record;
+    if (isValid && segment.nbRecords > 0 && ReadRecord(file, segment.nbRecords - 1, record)) {
+      segment.lastTimestamp = record.timestamp;
+    }
+  }
+  filesystem.FileClose(&file);
+
+  if (!isValid) {
+    segment = {};
+    return false;
+  }
+  segment.sequence = header.sequence;
+  segment.lastSourceSequence = header.lastSourceSequence;
+  segment.firstTimestamp = header.firstTimestamp;
+  segment.level = header.level;
+  return true;
+}
+
+// A reset between the rename and the delete of a compaction leaves the newest source of the merged segment next to it,
+// drop it: its records are already in the merged segment
+void TimeSeriesLog::DropMergedSources() {
+  for (uint8_t slot = 0; slot < maxSegments; slot++) {
+    for (uint8_t merged = 0; merged < maxSegments && segments[slot].sequence != 0; merged++) {
+      if (segments[merged].sequence != 0 && segments[merged].sequence < segments[slot].sequence &&
+          segments[slot].sequence <= segments[merged].lastSourceSequence) {
+        char path[maxPathLength];
+        SegmentPath(path, slot);
+        filesystem.FileDelete(path);
+        segments[slot] = {};
+      }
+    }
+  }
+}
+
+bool TimeSeriesLog::StartSegment(uint32_t firstTimestamp) {
+  if (activeSegment != noSegment) {
+    SealSegment(activeSegment);
+    activeSegment = noSegment;
+  }
+
+  uint8_t slot = noSegment;
+  for (uint8_t attempt = 0; attempt < 2 && slot == noSegment; attempt++) {
+    for (uint8_t i = 0; i < maxSegments; i++) {
+      if (segments[i].sequence == 0) {
+        slot = i;
+        break;
+      }
+    }
+    if (slot == noSegment && !FreeSegment()) {
+      return false;
+    }
+  }
+  if (slot == noSegment) {
+    return false;
+  }
+
+  Segment& segment = segments[slot];
+  segment = {};
+  segment.sequence = ++lastSequence;
+  segment.lastSourceSequence = segment.sequence;
+  segment.firstTimestamp = firstTimestamp;
+  segment.lastTimestamp = firstTimestamp;
+
+  char path[maxPathLength];
+  SegmentPath(path, slot);
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    segment = {};
+    return false;
+  }
+  bool isWritten = WriteHeader(file, segment);
+  filesystem.FileClose(&file);
+  if (!isWritten) {
+    segment = {};
+    return false;
+  }
+
+  activeSegment = slot;
+  return true;
+}
+
+// Append the trailer to a segment which no more records are appended to, so that it is not written again after a reset
+bool TimeSeriesLog::SealSegment(uint8_t slot) {
+  Segment& segment = segments[slot];
+  char path[maxPathLength];
+  SegmentPath(path, slot);
+  if (segment.nbRecords == 0) {
+    filesystem.FileDelete(path);
+    segment = {};
+    return true;
+  }
+
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_APPEND) != LFS_ERR_OK) {
+    return false;
+  }
+  bool isWritten = WriteTrailer(file, segment);
+  filesystem.FileClose(&file);
+  segment.isSealed = isWritten;
+  return isWritten;
+}
+
+bool TimeSeriesLog::WriteHeader(lfs_file_t& file, const Segment& segment) {
+  Header header;
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.level = segment.level;
+  header.padding = 0;
+  header.sequence = segment.sequence;
+  header.lastSourceSequence = segment.lastSourceSequence;
+  header.firstTimestamp = segment.firstTimestamp;
+  return filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header);
+}
+
+bool TimeSeriesLog::WriteTrailer(lfs_file_t& file, const Segment& segment) {
+  Trailer trailer;
+  std::memcpy(trailer.magic, trailerMagic, sizeof(trailerMagic));
+  trailer.nbRecords = segment.nbRecords;
+  trailer.padding = 0;
+  trailer.lastTimestamp = segment.lastTimestamp;
+  return filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&trailer), sizeof(trailer)) == sizeof(trailer);
+}
+
+// Make room for a new segment: merge the oldest two consecutive segments of the same level, so that the resolution of
+// the history decreases with its age, or drop the oldest segment when all of them reached the maximum level
+bool TimeSeriesLog::FreeSegment() {
+  uint8_t oldest = NextSegment(0);
+  if (oldest == noSegment) {
+    return false;
+  }
+
+  for (uint8_t first = oldest, second = NextSegment(segments[first].sequence); second != noSegment;
+       first = second, second = NextSegment(segments[second].sequence)) {
+    if (segments[first].level == segments[second].level && segments[first].level < maxLevel && second != activeSegment &&
+        segments[second].firstTimestamp >= segments[first].lastTimestamp && MergeSegments(first, second)) {
+      statistics.compactions++;
+      return true;
+    }
+  }
+
+  char path[maxPathLength];
+  SegmentPath(path, oldest);
+  filesystem.FileDelete(path);
+  segments[oldest] = {};
+  statistics.droppedSegments++;
+  return true;
+}
+
+// Merge the records of both segments by pairs into a temporary file, which then replaces the oldest segment.
+// The merged segment records the sequence of next, so that Init() drops next if the watch resets before it is deleted.
+bool TimeSeriesLog::MergeSegments(uint8_t oldest, uint8_t next) {
+  char temporaryPath[maxPathLength];
+  SegmentPath(temporaryPath, noSegment);
+  lfs_file_t output;
+  if (filesystem.FileOpen(&output, temporaryPath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return false;
+  }
+
+  Segment merged;
+  merged.sequence = segments[oldest].sequence;
+  merged.lastSourceSequence = segments[next].lastSourceSequence;
+  merged.firstTimestamp = segments[oldest].firstTimestamp;
+  merged.level = segments[oldest].level + 1;
+  merged.isSealed = true;
+  bool isMerged = WriteHeader(output, merged) && MergeRecords(output, oldest, merged) && MergeRecords(output, next, merged) &&
+                  WriteTrailer(output, merged);
+  filesystem.FileClose(&output);
+
+  char path[maxPathLength];
+  SegmentPath(path, oldest);
+  if (!isMerged || merged.nbRecords == 0 || filesystem.Rename(temporaryPath, path) != LFS_ERR_OK) {
+    filesystem.FileDelete(temporaryPath);
+    return false;
+  }
+  segments[oldest] = merged;
+
+  SegmentPath(path, next);
+  filesystem.FileDelete(path);
+  segments[next] = {};
+  return true;
+}
+
+bool TimeSeriesLog::MergeRecords(lfs_file_t& output, uint8_t slot, Segment& merged) {
+  char path[maxPathLength];
+  SegmentPath(path, slot);
+  lfs_file_t input;
+  if (filesystem.FileOpen(&input, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+
+  bool isMerged = filesystem.FileSeek(&input, sizeof(Header)) >= 0;
+  uint16_t remaining = segments[slot].nbRecords;
+  while (isMerged && remaining > 0) {
+    // mergeChunkRecords is even: the pairs do not span two chunks
+    uint8_t count = (remaining < mergeChunkRecords) ? remaining : mergeChunkRecords;
+    int size = count * sizeof(Record);
+    if (filesystem.FileRead(&input, reinterpret_cast<uint8_t*>(mergeChunk), size) != size) {
+      isMerged = false;
+      break;
+    }
+
+    uint8_t nbMerged = 0;
+    for (uint8_t i = 0; i < count; i += 2) {
+      Record record = mergeChunk[i];
+      if (i + 1 < count) {
+        const Record& second = mergeChunk[i + 1];
+        record.value = (aggregation == Aggregation::Average) ? static_cast<int32_t>((static_cast<int64_t>(record.value) + second.value) / 2)
+                                                             : second.value;
+      }
+      mergeChunk[nbMerged++] = record;
+    }
+
+    size = nbMerged * sizeof(Record);
+    isMerged = filesystem.FileWrite(&output, reinterpret_cast<const uint8_t*>(mergeChunk), size) == size;
+    merged.nbRecords += nbMerged;
+    merged.lastTimestamp = mergeChunk[nbMerged - 1].timestamp;
+    remaining -= count;
+  }
+  filesystem.FileClose(&input);
+  return isMerged;
+}
+
+bool TimeSeriesLog::ReadRecord(lfs_file_t& file, uint16_t index, Record& record) {
+  return filesystem.FileSeek(&file, sizeof(Header) + index * sizeof(Record)) >= 0 &&
+         filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(&record), sizeof(record)) == sizeof(record);
+}
+
+size_t TimeSeriesLog::QuerySegment(uint8_t slot, uint32_t from, uint32_t to, Record* records, size_t maxRecords) {
+  char path[maxPathLength];
+  SegmentPath(path, slot);
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return 0;
+  }
+
+  // Binary search of the first record at or after from
+  uint16_t low = 0;
+  uint16_t high = segments[slot].nbRecords;
+  bool isRead = true;
+  while (low < high) {
+    uint16_t middle = (low + high) / 2;
+    Record record;
+    isRead = ReadRecord(file, middle, record);
+    if (!isRead) {
+      break;
+    }
+    if (record.timestamp < from) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  // Read the following records in a single read, the ones after to are discarded
+  size_t count = 0;
+  if (isRead && filesystem.FileSeek(&file, sizeof(Header) + low * sizeof(Record)) >= 0) {
+    size_t available = segments[slot].nbRecords - low;
+    count = (available < maxRecords) ? available : maxRecords;
+    int size = count * sizeof(Record);
+    if (filesystem.FileRead(&file, reinterpret_cast<uint8_t*>(records), size) != size) {
+      count = 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+      if (records[i].timestamp > to) {
+        count = i;
+        break;
+      }
+    }
+  }
+  filesystem.FileClose(&file);
+  return count;
+}
+
+// Used segment with the smallest sequence number after afterSequence
+uint8_t TimeSeriesLog::NextSegment(uint32_t afterSequence) const {
+  uint8_t next = noSegment;
+  for (uint8_t slot = 0; slot < maxSegments; slot++) {
+    const Segment& segment = segments[slot];
+    if (segment.sequence > afterSequence && (next == noSegment || segment.sequence < segments[next].sequence)) {
+      next = slot;
+    }
+  }
+  return next;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <littlefs/lfs.h>
+
+// Records kept in RAM before they are written to the log, can be changed per build (-DTIME_SERIES_LOG_BATCH_RECORDS=32)
+#ifndef TIME_SERIES_LOG_BATCH_RECORDS
+  #define TIME_SERIES_LOG_BATCH_RECORDS 16
+#endif
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+
+    /* Append-only history of a value (steps, heart rate...) with a timestamp, stored in a directory of the filesystem.
+     *
+     * The log is a ring of maxSegments files ("<directory>/0" to "<directory>/7") of up to recordsPerSegment
+     * fixed-size records, so its size on the flash is bounded and files are reused instead of being created and
+     * deleted continuously. Each segment starts with a header holding its first time and its order in the log, the
+     * records of a segment are sorted by time. Once no more records are appended to a segment, it is sealed by a
+     * trailer holding its number of records and its last time. The time ranges are read once by Init(): queries only
+     * open the segments overlapping the requested range, and find the first record by a binary search.
+     *
+     * Files are only appended to, or replaced by a rename, so that the log stays consistent if the watch resets at any
+     * time.
+     *
+     * Appended records are kept in RAM until Flush(), which the owner calls once batchRecords are pending (IsFull()),
+     * so that a record every few seconds does not become a flash program every few seconds.
+     * When all the segments are used, the oldest two consecutive segments of the same level are compacted into one by
+     * merging their records by pairs (half the resolution, twice the time span), up to maxLevel times. Once all the
+     * segments reached that level, the oldest one is dropped.
+     */
+    class TimeSeriesLog {
+    public:
+      // How two records are merged during a compaction
+      enum class Aggregation : uint8_t { Average, Last };
+
+      struct Record {
+        // Seconds since the epoch
+        uint32_t timestamp;
+        int32_t value;
+      };
+
+      struct Statistics {
+        uint32_t appends = 0;
+        uint32_t flushes = 0;
+        uint32_t recordsWritten = 0;
+        uint32_t compactions = 0;
+        uint32_t droppedSegments = 0;
+        // Pending records overwritten because the log was not flushed in time
+        uint32_t droppedRecords = 0;
+      };
+
+      static constexpr uint8_t maxSegments = 8;
+      static constexpr uint16_t recordsPerSegment = 256;
+      static constexpr uint8_t batchRecords = TIME_SERIES_LOG_BATCH_RECORDS;
+      static constexpr uint8_t maxLevel = 3;
+
+      // directory is not copied and must be an absolute path of at most maxDirectoryLength characters
+      TimeSeriesLog(FS& filesystem, const char* directory, Aggregation aggregation);
+
+      TimeSeriesLog(const TimeSeriesLog&) = delete;
+      TimeSeriesLog& operator=(const TimeSeriesLog&) = delete;
+      TimeSeriesLog(TimeSeriesLog&&) = delete;
+      TimeSeriesLog& operator=(TimeSeriesLog&&) = delete;
+
+      // Create the directory of the log and read the headers of its segments, the filesystem must be mounted
+      void Init();
+
+      // Does not access the filesystem. When the batch is full, the oldest pending record is dropped.
+      void Append(uint32_t timestamp, int32_t value);
+      // Write the records kept in RAM
+      bool Flush();
+
+      bool IsFull() const {
+        return nbBatchRecords == batchRecords;
+      }
+
+      // Copy the records from the time from to the time to (included) into records, oldest first.
+      // Returns the number of records copied, at most maxRecords.
+      size_t Query(uint32_t from, uint32_t to, Record* records, size_t maxRecords);
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+    private:
+      struct Header {
+        char magic[4];
+        uint8_t version;
+        uint8_t level;
+        uint16_t padding;
+        uint32_t sequence;
+        // Sequence of the newest segment whose records were merged into this one, sequence if it was not compacted
+        uint32_t lastSourceSequence;
+        uint32_t firstTimestamp;
+      };
+      static_assert(sizeof(Header) == 20, "The header of the segments must not be padded");
+
+      // Its size is not a multiple of the size of the records, so that sealed segments are told apart by their size
+      struct Trailer {
+        char magic[4];
+        uint16_t nbRecords;
+        uint16_t padding;
+        uint32_t lastTimestamp;
+      };
+      static_assert(sizeof(Trailer) == 12 && sizeof(Trailer) % sizeof(Record) != 0, "The trailer must not be padded");
+
+      struct Segment {
+        // 0 when the slot is free
+        uint32_t sequence = 0;
+        uint32_t lastSourceSequence = 0;
+        uint32_t firstTimestamp = 0;
+        uint32_t lastTimestamp = 0;
+        uint16_t nbRecords = 0;
+        uint8_t level = 0;
+        bool isSealed = false;
+      };
+
+      static constexpr uint8_t version = 2;
+      static constexpr size_t maxDirectoryLength = 24;
+      static constexpr uint8_t noSegment = 0xff;
+      static constexpr uint8_t mergeChunkRecords = 8;
+
+      void SegmentPath(char* path, uint8_t slot) const;
+      bool LoadSegment(uint8_t slot);
+      bool StartSegment(uint32_t firstTimestamp);
+      bool SealSegment(uint8_t slot);
+      bool WriteHeader(lfs_file_t& file, const Segment& segment);
+      bool WriteTrailer(lfs_file_t& file, const Segment& segment);
+      void DropMergedSources();
+      bool FreeSegment();
+      bool MergeSegments(uint8_t oldest, uint8_t next);
+      bool MergeRecords(lfs_file_t& output, uint8_t slot, Segment& merged);
+      bool ReadRecord(lfs_file_t& file, uint16_t index, Record& record);
+      size_t QuerySegment(uint8_t slot, uint32_t from, uint32_t to, Record* records, size_t maxRecords);
+      uint8_t NextSegment(uint32_t afterSequence) const;
+
+      FS& filesystem;
+      const char* directory;
+      const Aggregation aggregation;
+
+      Segment segments[maxSegments];
+      uint8_t activeSegment = noSegment;
+      uint32_t lastSequence = 0;
+
+      Record batch[batchRecords];
+      uint8_t nbBatchRecords = 0;
+      Record mergeChunk[mergeChunkRecords];
+
+      Statistics statistics;
+    };
+  }
+}
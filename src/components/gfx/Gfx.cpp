@@ -1,5 +1,6 @@
 #include "components/gfx/Gfx.h"
 #include "drivers/St7789.h"
+#include <algorithm>
 using namespace Pinetime::Components;
 
 Gfx::Gfx(Pinetime::Drivers::St7789& lcd) : lcd {lcd} {
@@ -50,74 +51,108 @@ void Gfx::FillRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t* b)
 }
 
 void Gfx::DrawString(uint8_t x, uint8_t y, uint16_t color, const char* text, const FONT_INFO* p_font, bool wrap) {
-  if (y > (height - p_font->height)) {
-    // Not enough space to write even single char.
-    return;
-  }
-
-  uint8_t current_x = x;
-  uint8_t current_y = y;
+  uint16_t current_y = y;
+  size_t i = 0;
 
-  for (size_t i = 0; text[i] != '\0'; i++) {
-    if (text[i] == '\n') {
-      current_x = x;
-      current_y += p_font->height + p_font->height / 10;
-    } else {
-      DrawChar(p_font, (uint8_t) text[i], &current_x, current_y, color);
+  while (text[i] != '\0') {
+    if (current_y > (height - p_font->height)) {
+      // Not enough space to write even single char.
+      return;
     }
 
-    uint8_t char_idx = text[i] - p_font->startChar;
-    uint16_t char_width = text[i] == ' ' ? (p_font->height / 2) : p_font->charInfo[char_idx].widthBits;
-
-    if (current_x > (width - char_width)) {
-      if (wrap) {
-        current_x = x;
-        current_y += p_font->height + p_font->height / 10;
-      } else {
+    // Collect the characters that fit on this line and draw them as a single run
+    size_t runStart = i;
+    uint16_t runWidth = 0;
+    while (text[i] != '\0' && text[i] != '\n') {
+      uint8_t advance = CharAdvance(p_font, static_cast<uint8_t>(text[i]));
+      if (x + runWidth + advance > width) {
         break;
       }
+      runWidth += advance;
+      i++;
+    }
 
-      if (y > (height - p_font->height)) {
-        break;
+    DrawRun(p_font, &text[runStart], i - runStart, x, current_y, color);
+
+    if (text[i] == '\n') {
+      i++;
+    } else if (text[i] != '\0') {
+      if (!wrap || i == runStart) {
+        return;
       }
     }
+    current_y += p_font->height + p_font->height / 10;
   }
 }
 
 void Gfx::DrawChar(const FONT_INFO* font, uint8_t c, uint8_t* x, uint8_t y, uint16_t color) {
-  uint8_t char_idx = c - font->startChar;
-  uint16_t bytes_in_line = CEIL_DIV(font->charInfo[char_idx].widthBits, 8);
-  uint16_t bg = 0x0000;
+  DrawRun(font, reinterpret_cast<const char*>(&c), 1, *x, y, color);
+  *x += CharAdvance(font, c);
+}
 
+uint8_t Gfx::CharAdvance(const FONT_INFO* font, uint8_t c) const {
   if (c == ' ') {
-    *x += font->height / 2;
+    return font->height / 2;
+  }
+  if (c < font->startChar || c > font->endChar) {
+    return 0;
+  }
+  return font->charInfo[c - font->startChar].widthBits + font->spacePixels;
+}
+
+void Gfx::DrawRun(const FONT_INFO* font, const char* text, size_t count, uint8_t x, uint8_t y, uint16_t color) {
+  uint16_t runWidth = 0;
+  for (size_t i = 0; i < count; i++) {
+    runWidth += CharAdvance(font, static_cast<uint8_t>(text[i]));
+  }
+  runWidth = std::min(runWidth, static_cast<uint16_t>(width - x));
+  if (runWidth == 0) {
     return;
   }
 
-  // Build first line
-  for (uint16_t j = 0; j < bytes_in_line; j++) {
-    for (uint8_t k = 0; k < 8; k++) {
-      if ((1 << (7 - k)) & font->data[font->charInfo[char_idx].offset + j]) {
-        buffer[(j * 8) + k] = color;
-      } else {
-        buffer[(j * 8) + k] = bg;
-      }
-    }
+  // Narrow runs fit more lines in a strip, so short strings are usually sent in a single transfer
+  uint16_t linesPerStrip = std::min(static_cast<uint16_t>(font->height), static_cast<uint16_t>(stripSize / runWidth));
+  for (uint16_t line = 0; line < font->height; line += linesPerStrip) {
+    uint16_t lines = std::min(linesPerStrip, static_cast<uint16_t>(font->height - line));
+    RasteriseRun(font, text, count, runWidth, line, lines, color);
+    lcd.DrawBuffer(x, y + line, runWidth, lines, reinterpret_cast<const uint8_t*>(buffer), runWidth * lines * 2);
+    WaitTransferFinished();
   }
+}
 
-  state.remainingIterations = font->height + 0;
-  state.currentIteration = 0;
-  state.busy = true;
-  state.action = Action::DrawChar;
-  state.font = const_cast<FONT_INFO*>(font);
-  state.character = c;
-  state.color = color;
-  state.taskToNotify = xTaskGetCurrentTaskHandle();
+void Gfx::RasteriseRun(const FONT_INFO* font,
+                       const char* text,
+                       size_t count,
+                       uint16_t runWidth,
+                       uint16_t firstLine,
+                       uint16_t lines,
+                       uint16_t color) {
+  uint16_t bg = 0x0000;
 
-  lcd.DrawBuffer(*x, y, bytes_in_line * 8, font->height, reinterpret_cast<const uint8_t*>(&buffer), bytes_in_line * 8 * 2);
-  WaitTransferFinished();
+  for (uint16_t line = 0; line < lines; line++) {
+    uint16_t* row = &buffer[line * runWidth];
+    uint16_t px = 0;
+
+    for (size_t i = 0; i < count && px < runWidth; i++) {
+      uint8_t c = static_cast<uint8_t>(text[i]);
+      uint16_t advance = std::min(static_cast<uint16_t>(CharAdvance(font, c)), static_cast<uint16_t>(runWidth - px));
+      uint16_t glyphWidth = 0;
+
+      if (c != ' ' && advance > 0) {
+        const FONT_CHAR_INFO& charInfo = font->charInfo[c - font->startChar];
+        uint16_t bytes_in_line = CEIL_DIV(charInfo.widthBits, 8);
+        const uint8_t* bits = &font->data[charInfo.offset + (firstLine + line) * bytes_in_line];
+
+        glyphWidth = std::min(static_cast<uint16_t>(charInfo.widthBits), advance);
+        for (uint16_t k = 0; k < glyphWidth; k++) {
+          row[px + k] = ((1 << (7 - (k % 8))) & bits[k / 8]) ? color : bg;
+        }
+      }
 
-  *x += font->charInfo[char_idx].widthBits + font->spacePixels;
+      std::fill(&row[px + glyphWidth], &row[px + advance], bg);
+      px += advance;
+    }
+  }
 }
 
 void Gfx::pixel_draw(uint8_t x, uint8_t y, uint16_t color) {
@@ -151,23 +186,6 @@ bool Gfx::GetNextBuffer(uint8_t** data, size_t& size) {
   if (state.action == Action::FillRectangle) {
     *data = reinterpret_cast<uint8_t*>(buffer);
     size = width * 2;
-  } else if (state.action == Action::DrawChar) {
-    uint16_t bg = 0x0000;
-    uint8_t char_idx = state.character - state.font->startChar;
-    uint16_t bytes_in_line = CEIL_DIV(state.font->charInfo[char_idx].widthBits, 8);
-
-    for (uint16_t j = 0; j < bytes_in_line; j++) {
-      for (uint8_t k = 0; k < 8; k++) {
-        if ((1 << (7 - k)) & state.font->data[state.font->charInfo[char_idx].offset + ((state.currentIteration + 1) * bytes_in_line) + j]) {
-          buffer[(j * 8) + k] = state.color;
-        } else {
-          buffer[(j * 8) + k] = bg;
-        }
-      }
-    }
-
-    *data = reinterpret_cast<uint8_t*>(buffer);
-    size = bytes_in_line * 8 * 2;
   }
 
   state.currentIteration++;
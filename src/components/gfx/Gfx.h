@@ -32,8 +32,11 @@ namespace Pinetime {
     private:
       static constexpr uint8_t width = 240;
       static constexpr uint8_t height = 240;
+      // Text is rasterised into strips of the size of one full width line, one transfer per strip: a narrower run
+      // fits several of its lines in a strip. The buffer is not larger to keep the RAM of the recovery loader free.
+      static constexpr uint16_t stripSize = width;
 
-      enum class Action { None, FillRectangle, DrawChar };
+      enum class Action { None, FillRectangle };
 
       struct State {
         State() : busy {false}, action {Action::None}, remainingIterations {0}, currentIteration {0} {
@@ -43,17 +46,24 @@ namespace Pinetime {
         volatile Action action;
         volatile uint16_t remainingIterations;
         volatile uint16_t currentIteration;
-        volatile FONT_INFO* font;
         volatile uint16_t color;
-        volatile uint8_t character;
         volatile TaskHandle_t taskToNotify = nullptr;
       };
 
       volatile State state;
 
-      uint16_t buffer[width]; // 1 line buffer
+      uint16_t buffer[stripSize]; // Strip buffer, also the line repeated by FillRectangle()
       Drivers::St7789& lcd;
 
+      uint8_t CharAdvance(const FONT_INFO* font, uint8_t c) const;
+      void DrawRun(const FONT_INFO* font, const char* text, size_t count, uint8_t x, uint8_t y, uint16_t color);
+      void RasteriseRun(const FONT_INFO* font,
+                        const char* text,
+                        size_t count,
+                        uint16_t runWidth,
+                        uint16_t firstLine,
+                        uint16_t lines,
+                        uint16_t color);
       void SetBackgroundColor(uint16_t color);
       void WaitTransferFinished() const;
       void NotifyEndOfTransfer(TaskHandle_t task);
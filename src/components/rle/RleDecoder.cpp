@@ -1,4 +1,8 @@
 #include "components/rle/RleDecoder.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <algorithm>
+#include "drivers/St7789.h"
 
 using namespace Pinetime::Tools;
 
@@ -34,3 +38,27 @@ void RleDecoder::DecodeNext(uint8_t* output, size_t maxBytes) {
       color = backgroundColor;
   }
 }
+
+void RleDecoder::DecodeToDisplay(Drivers::St7789& lcd,
+                                 uint16_t width,
+                                 uint16_t height,
+                                 uint8_t* buffer1,
+                                 uint8_t* buffer2,
+                                 size_t bufferSize) {
+  static constexpr uint8_t bytesPerPixel = 2;
+  uint8_t* buffers[2] = {buffer1, buffer2};
+  uint16_t linesPerStrip = std::min(static_cast<size_t>(height), bufferSize / (width * bytesPerPixel));
+  uint8_t current = 0;
+
+  for (uint16_t line = 0; line < height; line += linesPerStrip) {
+    uint16_t lines = std::min(linesPerStrip, static_cast<uint16_t>(height - line));
+    size_t stripBytes = lines * width * bytesPerPixel;
+
+    // The strip sent from this buffer two iterations ago has ended, as its notification was taken before
+    // the last DrawBuffer(): decode into it while the previous strip is still being sent.
+    DecodeNext(buffers[current], stripBytes);
+    ulTaskNotifyTake(pdTRUE, 500);
+    lcd.DrawBuffer(0, line, width, lines, buffers[current], stripBytes);
+    current ^= 1;
+  }
+}
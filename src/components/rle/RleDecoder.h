@@ -4,6 +4,10 @@
 #include <cstddef>
 
 namespace Pinetime {
+  namespace Drivers {
+    class St7789;
+  }
+
   namespace Tools {
     /* 1-bit RLE decoder. Provide the encoded buffer to the constructor and then call DecodeNext() by
      * specifying the output (decoded) buffer and the maximum number of bytes this buffer can handle.
@@ -17,6 +21,20 @@ namespace Pinetime {
 
       void DecodeNext(uint8_t* output, size_t maxBytes);
 
+      /* Streaming mode: decodes the image strip by strip and draws it from the top left corner of the display. The next strip is
+       * decoded into the other buffer while the previous one is still being sent by DMA. Both buffers must be
+       * bufferSize bytes long and hold at least one line.
+       * Like the other users of DrawBuffer(), the calling task must hold a pending notification, meaning that the
+       * previous transfer has ended. It is taken before each strip, and given back when the transfer of the last
+       * strip, which may still be in progress when this method returns, ends.
+       */
+      void DecodeToDisplay(Drivers::St7789& lcd,
+                           uint16_t width,
+                           uint16_t height,
+                           uint8_t* buffer1,
+                           uint8_t* buffer2,
+                           size_t bufferSize);
+
     private:
       const uint8_t* buffer;
       size_t size;
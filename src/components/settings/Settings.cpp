@@ -1,47 +1,221 @@
 #include "components/settings/Settings.h"
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  constexpr char journalMagic[4] = {'I', 'S', 'E', 'T'};
+  constexpr const char* journalPath = "/settings.jnl";
+  constexpr const char* compactedJournalPath = "/settings.tmp";
+  // Written by the versions before the journal, as a copy of SettingsData
+  constexpr const char* legacyPath = "/settings.dat";
+  // Version of the settings written by the firmware without the always on display
+  constexpr uint32_t legacyVersionWithoutAlwaysOn = 0x0004;
+}
+
 Settings::Settings(Pinetime::Controllers::FS& fs) : fs {fs} {
 }
 
 void Settings::Init() {
 
   // Load default settings from Flash
-  LoadSettingsFromFile();
+  if (!LoadJournal() && LoadLegacySettings()) {
+    uint8_t entries[maxEntriesSize];
+    if (WriteJournal(entries)) {
+      fs.FileDelete(legacyPath);
+    }
+  }
+  savedSettings = settings;
 }
 
 void Settings::SaveSettings() {
 
   // verify if is necessary to save
   if (settingsChanged) {
-    SaveSettingsToFile();
+    isSavePending = true;
   }
   settingsChanged = false;
 }
 
-void Settings::LoadSettingsFromFile() {
+bool Settings::Flush() {
+  if (!isSavePending) {
+    return true;
+  }
+
+  uint8_t entries[maxEntriesSize];
+  size_t size = EncodeFields(entries, true);
+  bool written = true;
+  if (size > 0) {
+    if (journalSize == 0 || journalSize + size > maxJournalSize) {
+      written = WriteJournal(entries);
+    } else {
+      written = AppendToJournal(entries, size);
+    }
+  }
+
+  if (written) {
+    savedSettings = settings;
+    isSavePending = false;
+  }
+  return written;
+}
+
+template <typename T>
+Settings::Field Settings::MakeField(Key key, T& value) {
+  static_assert(sizeof(T) <= maxFieldSize, "The settings must fit in an entry of the journal");
+  return {key, sizeof(T), reinterpret_cast<uint8_t*>(&value)};
+}
+
+void Settings::GetFields(SettingsData& data, Field (&fields)[nbFields]) {
+  fields[0] = MakeField(Key::StepsGoal, data.stepsGoal);
+  fields[1] = MakeField(Key::ScreenTimeOut, data.screenTimeOut);
+  fields[2] = MakeField(Key::ClockType, data.clockType);
+  fields[3] = MakeField(Key::NotificationStatus, data.notificationStatus);
+  fields[4] = MakeField(Key::WatchFace, data.watchFace);
+  fields[5] = MakeField(Key::ChimesOption, data.chimesOption);
+  fields[6] = MakeField(Key::PTSColorTime, data.PTS.ColorTime);
+  fields[7] = MakeField(Key::PTSColorBar, data.PTS.ColorBar);
+  fields[8] = MakeField(Key::PTSColorBG, data.PTS.ColorBG);
+  fields[9] = MakeField(Key::PTSGaugeStyle, data.PTS.gaugeStyle);
+  fields[10] = MakeField(Key::InfineatShowSideCover, data.watchFaceInfineat.showSideCover);
+  fields[11] = MakeField(Key::InfineatColorIndex, data.watchFaceInfineat.colorIndex);
+  fields[12] = MakeField(Key::WakeUpMode, data.wakeUpMode);
+  fields[13] = MakeField(Key::ShakeWakeThreshold, data.shakeWakeThreshold);
+  fields[14] = MakeField(Key::BrightLevel, data.brightLevel);
+  fields[15] = MakeField(Key::AlwaysOnDisplay, data.alwaysOnDisplay);
+}
+
+// Write the entries of the settings (or of the settings changed since the last write) to entries, returns their size
+size_t Settings::EncodeFields(uint8_t* entries, bool changedOnly) {
+  Field fields[nbFields];
+  GetFields(settings, fields);
+
+  size_t size = 0;
+  for (uint8_t i = 0; i < nbFields; i++) {
+    const uint8_t* savedValue =
+      reinterpret_cast<const uint8_t*>(&savedSettings) + (fields[i].value - reinterpret_cast<const uint8_t*>(&settings));
+    if (changedOnly && std::memcmp(fields[i].value, savedValue, fields[i].size) == 0) {
+      continue;
+    }
+    entries[size++] = static_cast<uint8_t>(fields[i].key);
+    entries[size++] = fields[i].size;
+    std::memcpy(entries + size, fields[i].value, fields[i].size);
+    size += fields[i].size;
+  }
+  return size;
+}
+
+bool Settings::LoadJournal() {
+  lfs_file_t file;
+  if (fs.FileOpen(&file, journalPath, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+
+  JournalHeader header;
+  if (fs.FileRead(&file, reinterpret_cast<uint8_t*>(&header), sizeof(header)) != static_cast<int>(sizeof(header)) ||
+      std::memcmp(header.magic, journalMagic, sizeof(journalMagic)) != 0 || header.version != journalVersion) {
+    fs.FileClose(&file);
+    return false;
+  }
+
+  Field fields[nbFields];
+  GetFields(settings, fields);
+  uint32_t position = sizeof(header);
+  uint8_t entryHeader[entryHeaderSize];
+  while (fs.FileRead(&file, entryHeader, sizeof(entryHeader)) == static_cast<int>(sizeof(entryHeader))) {
+    uint8_t size = entryHeader[1];
+    const Field* field = nullptr;
+    for (const auto& f : fields) {
+      if (static_cast<uint8_t>(f.key) == entryHeader[0] && f.size == size) {
+        field = &f;
+        break;
+      }
+    }
+
+    if (field != nullptr) {
+      uint8_t value[maxFieldSize];
+      if (fs.FileRead(&file, value, size) != size) {
+        break;
+      }
+      std::memcpy(field->value, value, size);
+    } else {
+      // Setting written by another version of the firmware
+      if (fs.FileSeek(&file, position + sizeof(entryHeader) + size) < 0) {
+        break;
+      }
+    }
+    position += sizeof(entryHeader) + size;
+  }
+  fs.FileClose(&file);
+
+  journalSize = position;
+  return true;
+}
+
+bool Settings::LoadLegacySettings() {
   SettingsData bufferSettings;
   lfs_file_t settingsFile;
 
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_RDONLY) != LFS_ERR_OK) {
-    return;
+  if (fs.FileOpen(&settingsFile, legacyPath, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
   }
-  fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(settings));
+  int size = fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(bufferSettings));
   fs.FileClose(&settingsFile);
-  if (bufferSettings.version == settingsVersion) {
-    settings = bufferSettings;
+  if (size < static_cast<int>(sizeof(bufferSettings.version))) {
+    return false;
+  }
+
+  if (bufferSettings.version == legacyVersionWithoutAlwaysOn) {
+    // The layout of SettingsData without alwaysOnDisplay, which keeps its default value. The padding of the file
+    // may have been read over it.
+    if (size < static_cast<int>(offsetof(SettingsData, alwaysOnDisplay))) {
+      return false;
+    }
+    bufferSettings.alwaysOnDisplay = SettingsData {}.alwaysOnDisplay;
+  } else if (bufferSettings.version != settingsVersion || size != static_cast<int>(sizeof(bufferSettings))) {
+    return false;
   }
+  bufferSettings.version = settingsVersion;
+  settings = bufferSettings;
+  return true;
 }
 
-void Settings::SaveSettingsToFile() {
-  lfs_file_t settingsFile;
+bool Settings::AppendToJournal(const uint8_t* entries, size_t size) {
+  lfs_file_t file;
+  if (fs.FileOpen(&file, journalPath, LFS_O_WRONLY | LFS_O_APPEND) != LFS_ERR_OK) {
+    journalSize = 0;
+    return false;
+  }
+  bool written = fs.FileWrite(&file, entries, size) == static_cast<int>(size);
+  written = fs.FileClose(&file) == LFS_ERR_OK && written;
+
+  // A partially written entry would shift the following ones, the journal is written again on the next flush
+  journalSize = written ? journalSize + size : 0;
+  return written;
+}
 
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
-    return;
+// Write a journal holding one entry per setting next to the current one, then replace it: littlefs renames atomically,
+// the settings are not lost if the watch resets in the meantime.
+bool Settings::WriteJournal(uint8_t* entries) {
+  JournalHeader header;
+  std::memcpy(header.magic, journalMagic, sizeof(journalMagic));
+  header.version = journalVersion;
+  size_t size = EncodeFields(entries, false);
+
+  lfs_file_t file;
+  if (fs.FileOpen(&file, compactedJournalPath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return false;
   }
-  fs.FileWrite(&settingsFile, reinterpret_cast<uint8_t*>(&settings), sizeof(settings));
-  fs.FileClose(&settingsFile);
+  bool written = fs.FileWrite(&file, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == static_cast<int>(sizeof(header)) &&
+                 fs.FileWrite(&file, entries, size) == static_cast<int>(size);
+  written = fs.FileClose(&file) == LFS_ERR_OK && written;
+
+  if (!written || fs.Rename(compactedJournalPath, journalPath) != LFS_ERR_OK) {
+    fs.FileDelete(compactedJournalPath);
+    return false;
+  }
+  journalSize = sizeof(header) + size;
+  return true;
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <bitset>
 #include "components/brightness/BrightnessController.h"
@@ -60,7 +61,11 @@ namespace Pinetime {
       Settings& operator=(Settings&&) = delete;
 
       void Init();
+      // Request the changed settings to be written, they are only written by Flush()
       void SaveSettings();
+      // Append the settings changed since the last write to the journal. Called by SystemTask when the display goes to
+      // sleep, so that a setting changed several times in a row (brightness, quick settings...) is written once.
+      bool Flush();
 
       void SetWatchFace(Pinetime::Applications::WatchFace face) {
         if (face != settings.watchFace) {
@@ -256,6 +261,17 @@ namespace Pinetime {
         return settings.stepsGoal;
       };
 
+      void SetAlwaysOnDisplay(bool enabled) {
+        if (enabled != settings.alwaysOnDisplay) {
+          settingsChanged = true;
+        }
+        settings.alwaysOnDisplay = enabled;
+      };
+
+      bool GetAlwaysOnDisplay() const {
+        return settings.alwaysOnDisplay;
+      };
+
       void SetBleRadioEnabled(bool enabled) {
         bleRadioEnabled = enabled;
       };
@@ -267,7 +283,7 @@ namespace Pinetime {
     private:
       Pinetime::Controllers::FS& fs;
 
-      static constexpr uint32_t settingsVersion = 0x0004;
+      static constexpr uint32_t settingsVersion = 0x0005;
 
       struct SettingsData {
         uint32_t version = settingsVersion;
@@ -287,10 +303,62 @@ namespace Pinetime {
         std::bitset<4> wakeUpMode {0};
         uint16_t shakeWakeThreshold = 150;
         Controllers::BrightnessController::Levels brightLevel = Controllers::BrightnessController::Levels::Medium;
+        bool alwaysOnDisplay = false;
       };
 
+      /* The settings are stored as a journal of entries (key, size, value), after a header (magic "ISET", format
+       * version). Loading replays the entries in order: entries with an unknown key or an unexpected size are skipped
+       * and settings without an entry keep their default value, so adding a setting does not reset the others.
+       * Flush() appends the entries of the changed settings only. Once the journal reaches maxJournalSize, a copy
+       * holding one entry per setting is written and replaces it.
+       */
+      // Never change or reuse a key: add new settings at the end
+      enum class Key : uint8_t {
+        StepsGoal = 1,
+        ScreenTimeOut,
+        ClockType,
+        NotificationStatus,
+        WatchFace,
+        ChimesOption,
+        PTSColorTime,
+        PTSColorBar,
+        PTSColorBG,
+        PTSGaugeStyle,
+        InfineatShowSideCover,
+        InfineatColorIndex,
+        WakeUpMode,
+        ShakeWakeThreshold,
+        BrightLevel,
+        AlwaysOnDisplay,
+      };
+
+      struct Field {
+        Key key;
+        uint8_t size;
+        uint8_t* value;
+      };
+
+      struct JournalHeader {
+        char magic[4];
+        uint32_t version;
+      };
+
+      static constexpr uint8_t nbFields = 16;
+      static constexpr uint8_t maxFieldSize = 8;
+      static constexpr uint8_t entryHeaderSize = 2;
+      static constexpr uint32_t journalVersion = 1;
+      static constexpr uint32_t maxJournalSize = 512;
+
+      // Size of the entries of all the settings, at most
+      static constexpr size_t maxEntriesSize = sizeof(SettingsData) + nbFields * entryHeaderSize;
+
       SettingsData settings;
+      // Settings as they are stored in the journal
+      SettingsData savedSettings;
       bool settingsChanged = false;
+      bool isSavePending = false;
+      // 0 if the journal must be written again from scratch
+      uint32_t journalSize = 0;
 
       uint8_t appMenu = 0;
       uint8_t settingsMenu = 0;
@@ -300,8 +368,15 @@ namespace Pinetime {
        */
       bool bleRadioEnabled = true;
 
-      void LoadSettingsFromFile();
-      void SaveSettingsToFile();
+      template <typename T>
+      static Field MakeField(Key key, T& value);
+      static void GetFields(SettingsData& data, Field (&fields)[nbFields]);
+      size_t EncodeFields(uint8_t* entries, bool changedOnly);
+
+      bool LoadJournal();
+      bool LoadLegacySettings();
+      bool AppendToJournal(const uint8_t* entries, size_t size);
+      bool WriteJournal(uint8_t* entries);
     };
   }
 }
@@ -1,5 +1,6 @@
 #include "displayapp/DisplayApp.h"
 #include <libraries/log/nrf_log.h>
+#include <algorithm>
 #include "displayapp/screens/HeartRate.h"
 #include "displayapp/screens/Motion.h"
 #include "displayapp/screens/Timer.h"
@@ -12,6 +13,7 @@
 #include "components/motor/MotorController.h"
 #include "displayapp/screens/ApplicationList.h"
 #include "displayapp/screens/Clock.h"
+#include "displayapp/screens/WatchFaceInfineat.h"
 #include "displayapp/screens/FirmwareUpdate.h"
 #include "displayapp/screens/FirmwareValidation.h"
 #include "displayapp/screens/InfiniPaint.h"
@@ -95,7 +97,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
     touchHandler {touchHandler},
     filesystem {filesystem},
     lvgl {lcd, filesystem},
-    timer(this, TimerCallback) {
+    timer(this, TimerCallback),
+    refreshScheduler {dateTimeController, batteryController, bleController, heartRateController, motionController, notificationManager} {
 }
 
 void DisplayApp::Start(System::BootErrors error) {
@@ -167,7 +170,7 @@ void DisplayApp::Refresh() {
   };
 
   auto RestoreBrightness = [this]() {
-    if (brightnessController.Level() != Controllers::BrightnessController::Levels::Off) {
+    if (state != States::AlwaysOn && brightnessController.Level() != Controllers::BrightnessController::Levels::Off) {
       isDimmed = false;
       lv_disp_trig_activity(nullptr);
       ApplyBrightness();
@@ -182,16 +185,33 @@ void DisplayApp::Refresh() {
     return lv_disp_get_inactive_time(nullptr) >= pdMS_TO_TICKS(settingsController.GetScreenTimeOut());
   };
 
+  UpdatePowerState();
+
   TickType_t queueTimeout;
   switch (state) {
     case States::Idle:
       queueTimeout = portMAX_DELAY;
       break;
-    case States::Running:
+    case States::AlwaysOn:
+      if (dateTimeController.Minutes() != alwaysOnMinute) {
+        RefreshAlwaysOn();
+      }
+      // Wake up at the beginning of the next minute
+      queueTimeout = pdMS_TO_TICKS((60 - dateTimeController.Seconds()) * 1000);
+      break;
+    case States::Running: {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
+      TickType_t refreshTimeout = refreshScheduler.Run(*currentScreen);
       queueTimeout = lv_task_handler();
+      powerStatistics.taskHandlerRuns[static_cast<uint8_t>(powerState)]++;
+      // Screens refreshed by the scheduler do not need lvgl to run while it has nothing to draw
+      if (Any(currentScreen->GetRefreshEvents()) && lvgl.IsIdle()) {
+        queueTimeout = refreshTimeout;
+      } else {
+        queueTimeout = std::min(queueTimeout, refreshTimeout);
+      }
 
       if (!systemTask->IsSleepDisabled() && IsPastDimTime()) {
         if (!isDimmed) {
@@ -204,7 +224,13 @@ void DisplayApp::Refresh() {
       } else if (isDimmed) {
         RestoreBrightness();
       }
+
+      // Touch events and other messages still wake the task up while dimmed
+      if (isDimmed) {
+        queueTimeout = std::max(queueTimeout, pdMS_TO_TICKS(dimmedRefreshPeriod));
+      }
       break;
+    }
     default:
       queueTimeout = portMAX_DELAY;
       break;
@@ -220,6 +246,17 @@ void DisplayApp::Refresh() {
         RestoreBrightness();
         break;
       case Messages::GoToSleep:
+        if (settingsController.GetAlwaysOnDisplay()) {
+          brightnessController.Set(Controllers::BrightnessController::Levels::Low);
+          lvgl.SetRefreshClip(alwaysOnFirstLine, alwaysOnLastLine);
+          // PTLAR, PTLON and IDMON toggle DC, which must not change while the last flush is being sent
+          lvgl.WaitForFlush();
+          lcd.LowPowerOn(alwaysOnFirstLine, alwaysOnLastLine);
+          alwaysOnMinute = dateTimeController.Minutes();
+          PushMessageToSystemTask(Pinetime::System::Messages::OnDisplayTaskSleeping);
+          state = States::AlwaysOn;
+          break;
+        }
         while (brightnessController.Level() != Controllers::BrightnessController::Levels::Off) {
           brightnessController.Lower();
           vTaskDelay(100);
@@ -229,9 +266,17 @@ void DisplayApp::Refresh() {
         state = States::Idle;
         break;
       case Messages::GoToRunning:
-        lcd.Wakeup();
+        if (state == States::AlwaysOn) {
+          lcd.LowPowerOff();
+          lvgl.ClearRefreshClip();
+          // Redraw what was not refreshed outside of the always on band
+          lv_obj_invalidate(lv_scr_act());
+        } else {
+          lcd.Wakeup();
+        }
         lv_disp_trig_activity(nullptr);
         ApplyBrightness();
+        isDimmed = false;
         state = States::Running;
         break;
       case Messages::UpdateBleConnection:
@@ -376,6 +421,43 @@ void DisplayApp::Refresh() {
   }
 }
 
+void DisplayApp::RefreshAlwaysOn() {
+  alwaysOnMinute = dateTimeController.Minutes();
+  // Let the current screen update its content, then redraw the always on band right away instead of
+  // waiting for the next lvgl refresh period. Watch faces subscribed to refresh events have no lv_task of their own.
+  refreshScheduler.Run(*currentScreen);
+  lv_task_handler();
+  powerStatistics.taskHandlerRuns[static_cast<uint8_t>(powerState)]++;
+  lvgl.RefreshNow();
+}
+
+void DisplayApp::UpdatePowerState() {
+  PowerStates newState = PowerStates::Off;
+  if (state == States::Running) {
+    newState = isDimmed ? PowerStates::Dimmed : PowerStates::Active;
+  }
+  if (newState == powerState) {
+    return;
+  }
+
+  TickType_t now = xTaskGetTickCount();
+  powerStatistics.ticksInState[static_cast<uint8_t>(powerState)] += now - powerStateStart;
+  powerStatistics.transitions++;
+  powerStateStart = now;
+  powerState = newState;
+
+  // Animations and screens refreshing themselves are not worth drawing at full rate behind a dimmed backlight
+  lvgl.SetRefreshPeriod(powerState == PowerStates::Dimmed ? dimmedRefreshPeriod : LV_DISP_DEF_REFR_PERIOD);
+}
+
+TickType_t DisplayApp::GetTicksInPowerState(PowerStates state) const {
+  TickType_t ticks = powerStatistics.ticksInState[static_cast<uint8_t>(state)];
+  if (state == powerState) {
+    ticks += xTaskGetTickCount() - powerStateStart;
+  }
+  return ticks;
+}
+
 void DisplayApp::StartApp(Apps app, DisplayApp::FullRefreshDirections direction) {
   nextApp = app;
   nextDirection = direction;
@@ -399,6 +481,8 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
 
   currentScreen.reset(nullptr);
   SetFullRefresh(direction);
+  // Only the watch face keeps its images in RAM, free them when another app is loaded
+  lvgl.EnableImageCache(app == Apps::Clock || app == Apps::None);
 
   switch (app) {
     case Apps::Launcher:
@@ -410,6 +494,10 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
       // break;
     case Apps::None:
     case Apps::Clock:
+      // Load the images of the watch face before the screen is built
+      if (settingsController.GetWatchFace() == WatchFace::Infineat) {
+        Screens::WatchFaceInfineat::PrefetchImages(lvgl.GetImageCache());
+      }
       currentScreen = std::make_unique<Screens::Clock>(dateTimeController,
                                                        batteryController,
                                                        bleController,
@@ -509,7 +597,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             bleController,
                                                             watchdog,
                                                             motionController,
-                                                            touchPanel);
+                                                            touchPanel,
+                                                            filesystem,
+                                                            lvgl);
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
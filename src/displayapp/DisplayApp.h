@@ -6,6 +6,7 @@
 #include <systemtask/Messages.h>
 #include "displayapp/Apps.h"
 #include "displayapp/LittleVgl.h"
+#include "displayapp/RefreshScheduler.h"
 #include "displayapp/TouchEvents.h"
 #include "components/brightness/BrightnessController.h"
 #include "components/motor/MotorController.h"
@@ -47,7 +48,19 @@ namespace Pinetime {
   namespace Applications {
     class DisplayApp {
     public:
-      enum class States { Idle, Running };
+      enum class States { Idle, Running, AlwaysOn };
+      // What the display task spends CPU time on: rendering at full rate, rendering at a reduced rate while the
+      // backlight is dimmed before going to sleep, or nothing while the display is off (apart from the minute
+      // refresh of the always on display).
+      enum class PowerStates : uint8_t { Active, Dimmed, Off };
+      static constexpr uint8_t nbPowerStates = 3;
+
+      struct PowerStatistics {
+        // Indexed by PowerStates. The time spent in the current state is added when it is left.
+        TickType_t ticksInState[nbPowerStates] = {};
+        uint32_t taskHandlerRuns[nbPowerStates] = {};
+        uint32_t transitions = 0;
+      };
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
 
       DisplayApp(Drivers::St7789& lcd,
@@ -74,6 +87,17 @@ namespace Pinetime {
 
       void Register(Pinetime::System::SystemTask* systemTask);
 
+      PowerStates GetPowerState() const {
+        return powerState;
+      }
+
+      const PowerStatistics& GetPowerStatistics() const {
+        return powerStatistics;
+      }
+
+      // Time spent in the state, including the time spent so far if it is the current state
+      TickType_t GetTicksInPowerState(PowerStates state) const;
+
     private:
       Pinetime::Drivers::St7789& lcd;
       const Pinetime::Drivers::Cst816S& touchPanel;
@@ -95,6 +119,7 @@ namespace Pinetime {
       Pinetime::Controllers::FirmwareValidator validator;
       Pinetime::Components::LittleVgl lvgl;
       Pinetime::Controllers::Timer timer;
+      RefreshScheduler refreshScheduler;
 
       TaskHandle_t taskHandle;
 
@@ -129,6 +154,19 @@ namespace Pinetime {
       Utility::StaticStack<FullRefreshDirections, returnAppStackSize> appStackDirections;
 
       bool isDimmed = false;
+
+      // Frame period while the screen is dimmed, the screen goes to sleep shortly after anyway
+      static constexpr uint32_t dimmedRefreshPeriod = 200;
+      PowerStates powerState = PowerStates::Active;
+      TickType_t powerStateStart = 0;
+      PowerStatistics powerStatistics;
+      void UpdatePowerState();
+
+      // Lines kept on in always on mode, the time of most watch faces is drawn in this band
+      static constexpr lv_coord_t alwaysOnFirstLine = 60;
+      static constexpr lv_coord_t alwaysOnLastLine = 179;
+      uint8_t alwaysOnMinute = 0;
+      void RefreshAlwaysOn();
     };
   }
 }
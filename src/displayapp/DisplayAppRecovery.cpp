@@ -92,11 +92,7 @@ void DisplayApp::Refresh() {
 
 void DisplayApp::DisplayLogo(uint16_t color) {
   Pinetime::Tools::RleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb), color, colorBlack);
-  for (int i = 0; i < displayWidth; i++) {
-    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
-    ulTaskNotifyTake(pdTRUE, 500);
-    lcd.DrawBuffer(0, i, displayWidth, 1, reinterpret_cast<const uint8_t*>(displayBuffer), displayWidth * bytesPerPixel);
-  }
+  rleDecoder.DecodeToDisplay(lcd, displayWidth, displayHeight, displayBuffer, secondDisplayBuffer, sizeof(displayBuffer));
 }
 
 void DisplayApp::DisplayOtaProgress(uint8_t percent, uint16_t color) {
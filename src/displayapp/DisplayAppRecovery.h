@@ -83,6 +83,7 @@ namespace Pinetime {
       static constexpr uint8_t displayWidth = 240;
       static constexpr uint8_t displayHeight = 240;
       static constexpr uint8_t bytesPerPixel = 2;
+      static constexpr uint8_t stripLines = 4;
 
       static constexpr uint16_t colorWhite = 0xFFFF;
       static constexpr uint16_t colorGreen = 0x07E0;
@@ -91,7 +92,8 @@ namespace Pinetime {
       static constexpr uint16_t colorRed = 0xff00;
       static constexpr uint16_t colorRedSwapped = 0x00ff;
       static constexpr uint16_t colorBlack = 0x0000;
-      uint8_t displayBuffer[displayWidth * bytesPerPixel];
+      uint8_t displayBuffer[displayWidth * bytesPerPixel * stripLines];
+      uint8_t secondDisplayBuffer[displayWidth * bytesPerPixel * stripLines];
     };
   }
 }
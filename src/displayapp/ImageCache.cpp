@@ -0,0 +1,240 @@
+#include "displayapp/ImageCache.h"
+#include <cstring>
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Only images are cached, other files (fonts, ...) are opened from the filesystem
+  constexpr char cachedDirectory[] = "/images/";
+}
+
+ImageCache::ImageCache(Pinetime::Controllers::FS& filesystem, uint32_t budget) : filesystem {filesystem}, budget {budget} {
+}
+
+lv_fs_res_t ImageCache::Open(File& file, const char* path) {
+  char normalised[maxPathLength];
+  if (NormalisePath(normalised, path)) {
+    path = normalised;
+  }
+
+  file.position = 0;
+  file.isPacked = false;
+  file.entry = Find(path);
+  if (file.entry != nullptr) {
+    statistics.hits++;
+    file.entry->lastUse = ++useCounter;
+    file.entry->openCount++;
+    return LV_FS_RES_OK;
+  }
+
+  if (IsCacheable(path)) {
+    statistics.misses++;
+    file.entry = Load(path);
+    if (file.entry != nullptr) {
+      file.entry->openCount++;
+      return LV_FS_RES_OK;
+    }
+    statistics.uncached++;
+  }
+
+  if (filesystem.GetResourcePack().Find(path, file.asset)) {
+    statistics.packed++;
+    file.isPacked = true;
+    return LV_FS_RES_OK;
+  }
+
+  int res = filesystem.FileOpen(&file.file, path, LFS_O_RDONLY);
+  if (res == 0) {
+    if (file.file.type == 0) {
+      return LV_FS_RES_FS_ERR;
+    } else {
+      return LV_FS_RES_OK;
+    }
+  }
+  return LV_FS_RES_NOT_EX;
+}
+
+lv_fs_res_t ImageCache::Close(File& file) {
+  if (file.entry != nullptr) {
+    file.entry->openCount--;
+    file.entry = nullptr;
+    // Apply a budget reduced while the file was open
+    MakeRoom(0);
+  } else if (!file.isPacked) {
+    filesystem.FileClose(&file.file);
+  }
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t ImageCache::Read(File& file, void* buffer, uint32_t size, uint32_t* sizeRead) {
+  if (file.isPacked) {
+    *sizeRead = filesystem.GetResourcePack().Read(file.asset, file.position, static_cast<uint8_t*>(buffer), size);
+    file.position += *sizeRead;
+    return LV_FS_RES_OK;
+  }
+
+  if (file.entry == nullptr) {
+    int res = filesystem.FileRead(&file.file, static_cast<uint8_t*>(buffer), size);
+    if (res < 0) {
+      *sizeRead = 0;
+      return LV_FS_RES_FS_ERR;
+    }
+    *sizeRead = res;
+    return LV_FS_RES_OK;
+  }
+
+  uint32_t available = (file.position < file.entry->size) ? file.entry->size - file.position : 0;
+  if (size > available) {
+    size = available;
+  }
+  std::memcpy(buffer, &file.entry->data[file.position], size);
+  file.position += size;
+  *sizeRead = size;
+  return LV_FS_RES_OK;
+}
+
+lv_fs_res_t ImageCache::Seek(File& file, uint32_t position) {
+  if (file.entry == nullptr && !file.isPacked) {
+    filesystem.FileSeek(&file.file, position);
+  } else {
+    file.position = position;
+  }
+  return LV_FS_RES_OK;
+}
+
+bool ImageCache::Prefetch(const char* path) {
+  char normalised[maxPathLength];
+  if (!NormalisePath(normalised, path)) {
+    return false;
+  }
+  path = normalised;
+
+  Entry* entry = Find(path);
+  if (entry != nullptr) {
+    entry->lastUse = ++useCounter;
+    return true;
+  }
+  return Load(path) != nullptr;
+}
+
+void ImageCache::SetBudget(uint32_t newBudget) {
+  budget = newBudget;
+  MakeRoom(0);
+}
+
+// Give the path a single leading '/', so that a file has the same key in the cache and the same id in the resource pack
+// whether it comes from lvgl or from Prefetch(). Returns false if the path is too long to be cached.
+bool ImageCache::NormalisePath(char* normalised, const char* path) {
+  while (*path == '/') {
+    path++;
+  }
+  size_t length = std::strlen(path);
+  if (length + 1 >= maxPathLength) {
+    return false;
+  }
+  normalised[0] = '/';
+  std::memcpy(&normalised[1], path, length + 1);
+  return true;
+}
+
+bool ImageCache::IsCacheable(const char* path) {
+  return std::strncmp(path, cachedDirectory, sizeof(cachedDirectory) - 1) == 0 && std::strlen(path) < maxPathLength;
+}
+
+ImageCache::Entry* ImageCache::Find(const char* path) {
+  for (auto& entry : entries) {
+    if (entry.data != nullptr && std::strcmp(entry.path, path) == 0) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+ImageCache::Entry* ImageCache::Load(const char* path) {
+  if (!IsCacheable(path)) {
+    return nullptr;
+  }
+
+  // Read the file from the resource pack when it contains it, the size is known without looking the file up
+  auto& resourcePack = filesystem.GetResourcePack();
+  Pinetime::Controllers::ResourcePack::Asset asset;
+  bool isPacked = resourcePack.Find(path, asset);
+  lfs_info info;
+  if (isPacked) {
+    info.size = asset.size;
+  } else if (filesystem.Stat(path, &info) != 0 || info.type != LFS_TYPE_REG) {
+    return nullptr;
+  }
+  if (info.size > budget || !MakeRoom(info.size)) {
+    return nullptr;
+  }
+
+  Entry* entry = nullptr;
+  for (auto& candidate : entries) {
+    if (candidate.data == nullptr) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (entry == nullptr) {
+    return nullptr;
+  }
+
+  int res;
+  if (isPacked) {
+    entry->data = std::make_unique<uint8_t[]>(info.size);
+    res = resourcePack.Read(asset, 0, entry->data.get(), info.size);
+  } else {
+    lfs_file_t file;
+    if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) != 0) {
+      return nullptr;
+    }
+    entry->data = std::make_unique<uint8_t[]>(info.size);
+    res = filesystem.FileRead(&file, entry->data.get(), info.size);
+    filesystem.FileClose(&file);
+  }
+  if (res != static_cast<int>(info.size)) {
+    entry->data.reset();
+    return nullptr;
+  }
+
+  std::strncpy(entry->path, path, maxPathLength - 1);
+  entry->size = info.size;
+  entry->lastUse = ++useCounter;
+  entry->openCount = 0;
+  bytesCached += info.size;
+  return entry;
+}
+
+// Evict the least recently used files until size bytes and an entry are available
+bool ImageCache::MakeRoom(uint32_t size) {
+  while (true) {
+    bool entryAvailable = false;
+    Entry* leastRecentlyUsed = nullptr;
+    for (auto& entry : entries) {
+      if (entry.data == nullptr) {
+        entryAvailable = true;
+      } else if (entry.openCount == 0 && (leastRecentlyUsed == nullptr || entry.lastUse < leastRecentlyUsed->lastUse)) {
+        leastRecentlyUsed = &entry;
+      }
+    }
+
+    bool fits = bytesCached + size <= budget;
+    if (fits && (entryAvailable || size == 0)) {
+      return true;
+    }
+    if (leastRecentlyUsed == nullptr) {
+      return false;
+    }
+    Evict(*leastRecentlyUsed);
+  }
+}
+
+void ImageCache::Evict(Entry& entry) {
+  statistics.evictions++;
+  bytesCached -= entry.size;
+  entry.data.reset();
+  entry.path[0] = '\0';
+  entry.size = 0;
+  entry.lastUse = 0;
+}
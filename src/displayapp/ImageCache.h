@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <lvgl/lvgl.h>
+#include "components/fs/FS.h"
+
+namespace Pinetime {
+  namespace Components {
+    /* Keeps the content of the images of the filesystem in RAM, so that drawing them again (after a screen switch, or
+     * each time the part of the screen containing them is refreshed) does not read the external flash.
+     *
+     * Files are cached whole when they are opened, up to a byte budget. When the budget is exceeded, the least recently
+     * used files that are not open are evicted. Files which do not fit in the budget are read from the resource pack
+     * when it contains them, from the filesystem otherwise.
+     */
+    class ImageCache {
+      struct Entry;
+
+    public:
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        // Files opened from the resource pack or the filesystem because they could not be cached
+        uint32_t uncached = 0;
+        uint32_t packed = 0;
+      };
+
+      // State of a file opened through the cache, allocated by lvgl for each opened file
+      struct File {
+        lfs_file_t file;
+        Entry* entry;
+        // Files read from the resource pack
+        bool isPacked;
+        Pinetime::Controllers::ResourcePack::Asset asset;
+        uint32_t position;
+      };
+
+      ImageCache(Pinetime::Controllers::FS& filesystem, uint32_t budget);
+
+      ImageCache(const ImageCache&) = delete;
+      ImageCache& operator=(const ImageCache&) = delete;
+      ImageCache(ImageCache&&) = delete;
+      ImageCache& operator=(ImageCache&&) = delete;
+
+      // path is given by lvgl without the drive letter and its leading '/' ("images/a.bin" for "F:/images/a.bin")
+      lv_fs_res_t Open(File& file, const char* path);
+      lv_fs_res_t Close(File& file);
+      lv_fs_res_t Read(File& file, void* buffer, uint32_t size, uint32_t* sizeRead);
+      lv_fs_res_t Seek(File& file, uint32_t position);
+
+      // Load the file in the cache before it is opened, for example when the screen using it is about to be displayed
+      bool Prefetch(const char* path);
+
+      // The budget can be changed at any time, files are evicted until the cache fits in the new budget
+      void SetBudget(uint32_t newBudget);
+
+      uint32_t GetBudget() const {
+        return budget;
+      }
+
+      uint32_t GetBytesCached() const {
+        return bytesCached;
+      }
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
+    private:
+      static constexpr uint8_t maxEntries = 4;
+      static constexpr size_t maxPathLength = 48;
+
+      struct Entry {
+        char path[maxPathLength] = {};
+        std::unique_ptr<uint8_t[]> data;
+        uint32_t size = 0;
+        uint32_t lastUse = 0;
+        uint8_t openCount = 0;
+      };
+
+      static bool NormalisePath(char* normalised, const char* path);
+      static bool IsCacheable(const char* path);
+      Entry* Find(const char* path);
+      Entry* Load(const char* path);
+      bool MakeRoom(uint32_t size);
+      void Evict(Entry& entry);
+
+      Pinetime::Controllers::FS& filesystem;
+      uint32_t budget;
+      uint32_t bytesCached = 0;
+      uint32_t useCounter = 0;
+      Entry entries[maxEntries];
+      Statistics statistics;
+    };
+  }
+}
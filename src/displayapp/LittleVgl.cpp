@@ -1,8 +1,10 @@
 #include "displayapp/LittleVgl.h"
 #include "displayapp/InfiniTimeTheme.h"
+#include "displayapp/Rgb565.h"
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <libraries/log/nrf_log.h>
 #include "drivers/St7789.h"
 #include "littlefs/lfs.h"
 #include "components/fs/FS.h"
@@ -16,40 +18,23 @@ namespace {
   }
 
   lv_fs_res_t lvglOpen(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    int res = filesys->FileOpen(file, path, LFS_O_RDONLY);
-    if (res == 0) {
-      if (file->type == 0) {
-        return LV_FS_RES_FS_ERR;
-      } else {
-        return LV_FS_RES_OK;
-      }
-    }
-    return LV_FS_RES_NOT_EX;
+    auto* imageCache = static_cast<ImageCache*>(drv->user_data);
+    return imageCache->Open(*static_cast<ImageCache::File*>(file_p), path);
   }
 
   lv_fs_res_t lvglClose(lv_fs_drv_t* drv, void* file_p) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileClose(file);
-
-    return LV_FS_RES_OK;
+    auto* imageCache = static_cast<ImageCache*>(drv->user_data);
+    return imageCache->Close(*static_cast<ImageCache::File*>(file_p));
   }
 
   lv_fs_res_t lvglRead(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileRead(file, static_cast<uint8_t*>(buf), btr);
-    *br = btr;
-    return LV_FS_RES_OK;
+    auto* imageCache = static_cast<ImageCache*>(drv->user_data);
+    return imageCache->Read(*static_cast<ImageCache::File*>(file_p), buf, btr, br);
   }
 
   lv_fs_res_t lvglSeek(lv_fs_drv_t* drv, void* file_p, uint32_t pos) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileSeek(file, pos);
-    return LV_FS_RES_OK;
+    auto* imageCache = static_cast<ImageCache*>(drv->user_data);
+    return imageCache->Seek(*static_cast<ImageCache::File*>(file_p), pos);
   }
 }
 
@@ -58,6 +43,19 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
   lvgl->FlushDisplay(area, color_p);
 }
 
+static void monitor(lv_disp_drv_t* disp_drv, uint32_t time, uint32_t px) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->OnRefreshFinished(time, px);
+}
+
+static void refresh_task(lv_task_t* task) {
+  auto* disp = static_cast<lv_disp_t*>(task->user_data);
+  auto* lvgl = static_cast<LittleVgl*>(disp->driver.user_data);
+  lvgl->ClipInvalidAreas(disp);
+  lvgl->CoalesceInvalidAreas(disp);
+  _lv_disp_refr_task(task);
+}
+
 static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
   if (lvgl->GetFullRefresh()) {
@@ -68,12 +66,17 @@ static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   }
 }
 
+static void gpu_blend(lv_disp_drv_t* /*disp_drv*/, lv_color_t* dest, const lv_color_t* src, uint32_t length, lv_opa_t opa) {
+  Rgb565::BlendPixels(reinterpret_cast<uint16_t*>(dest), reinterpret_cast<const uint16_t*>(src), length, opa);
+}
+
 bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
   auto* lvgl = static_cast<LittleVgl*>(indev_drv->user_data);
   return lvgl->GetTouchPadInfo(data);
 }
 
-LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem) : lcd {lcd}, filesystem {filesystem} {
+LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem)
+  : lcd {lcd}, filesystem {filesystem}, imageCache {filesystem, imageCacheBudget} {
 }
 
 void LittleVgl::Init() {
@@ -100,9 +103,15 @@ void LittleVgl::InitDisplay() {
   disp_drv.buffer = &disp_buf_2;
   disp_drv.user_data = this;
   disp_drv.rounder_cb = rounder;
+  disp_drv.monitor_cb = monitor;
+  /*Blend images and opacity layers with the three channels of a pixel mixed at once in a 32 bit word*/
+  disp_drv.gpu_blend_cb = gpu_blend;
 
   /*Finally register the driver*/
-  lv_disp_drv_register(&disp_drv);
+  lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+
+  /*Merge the invalid areas before lvgl refreshes them*/
+  lv_task_set_cb(disp->refr_task, refresh_task);
 }
 
 void LittleVgl::InitTouchpad() {
@@ -119,19 +128,25 @@ void LittleVgl::InitFileSystem() {
   lv_fs_drv_t fs_drv;
   lv_fs_drv_init(&fs_drv);
 
-  fs_drv.file_size = sizeof(lfs_file_t);
+  fs_drv.file_size = sizeof(ImageCache::File);
   fs_drv.letter = 'F';
   fs_drv.open_cb = lvglOpen;
   fs_drv.close_cb = lvglClose;
   fs_drv.read_cb = lvglRead;
   fs_drv.seek_cb = lvglSeek;
 
-  fs_drv.user_data = &filesystem;
+  fs_drv.user_data = &imageCache;
 
   lv_fs_drv_register(&fs_drv);
 }
 
 void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
+  // Without a direction, nothing may be invalidated (InfiniPaint calls it on each touch) and no refresh would end it
+  if (!isTransitionRunning && direction != FullRefreshDirections::None) {
+    isTransitionRunning = true;
+    transitionStart = xTaskGetTickCount();
+    transitionFrames = 0;
+  }
   if (scrollDirection == FullRefreshDirections::None) {
     scrollDirection = direction;
     if (scrollDirection == FullRefreshDirections::Down) {
@@ -151,6 +166,7 @@ void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
 
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   uint16_t y1, y2, width, height = 0;
+  TickType_t flushStart = xTaskGetTickCount();
 
   ulTaskNotifyTake(pdTRUE, 200);
   // Notification is still needed (even if there is a mutex on SPI) because of the DataCommand pin
@@ -186,7 +202,7 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
         toScroll -= scrollOffset;
         scrollOffset = (totalNbLines) -toScroll;
       }
-      lcd.VerticalScrollStartAddress(scrollOffset);
+      lcd.QueueVerticalScrollStartAddress(scrollOffset);
     }
 
   } else if (scrollDirection == FullRefreshDirections::Up) {
@@ -200,7 +216,7 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
         scrollOffset += height;
       }
       scrollOffset = scrollOffset % totalNbLines;
-      lcd.VerticalScrollStartAddress(scrollOffset);
+      lcd.QueueVerticalScrollStartAddress(scrollOffset);
     }
   } else if (scrollDirection == FullRefreshDirections::Left or scrollDirection == FullRefreshDirections::LeftAnim) {
     if (area->x2 == visibleNbLines - 1) {
@@ -214,28 +230,205 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     }
   }
 
+  uint32_t flushLatencyMs = (xTaskGetTickCount() - flushStart) * 1000 / configTICK_RATE_HZ;
+  flushStatistics.totalFlushLatencyMs += flushLatencyMs;
+  if (flushLatencyMs > flushStatistics.maxFlushLatencyMs) {
+    flushStatistics.maxFlushLatencyMs = flushLatencyMs;
+  }
+
   if (y2 < y1) {
     height = totalNbLines - y1;
 
     if (height > 0) {
       lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+      frameDrawBufferCalls++;
       ulTaskNotifyTake(pdTRUE, 100);
     }
 
     uint16_t pixOffset = width * height;
     height = y2 + 1;
     lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), width * height * 2);
+    frameDrawBufferCalls++;
 
   } else {
     lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    frameDrawBufferCalls++;
   }
+  frameFlushedPixels += lv_area_get_size(area);
+  if (isTransitionRunning) {
+    transitionFrames++;
+  }
+
+  flushStatistics.flushes++;
+  flushStatistics.bytesSent += lv_area_get_size(area) * sizeof(lv_color_t);
 
   // IMPORTANT!!!
   // Inform the graphics library that you are ready with the flushing
   lv_disp_flush_ready(&disp_drv);
 }
 
+void LittleVgl::FillAreas(const lv_area_t* areas, size_t count, const lv_color_t* color_p) {
+  Drivers::St7789::Window windows[Drivers::St7789::maxWindows];
+  size_t nbWindows = 0;
+
+  auto SendWindows = [this, &windows, &nbWindows, color_p]() {
+    ulTaskNotifyTake(pdTRUE, 200);
+    lcd.DrawBufferToWindows(windows, nbWindows, reinterpret_cast<const uint8_t*>(color_p));
+    frameDrawBufferCalls++;
+    flushStatistics.flushes++;
+    nbWindows = 0;
+  };
+  auto AddWindow = [&](uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    if (nbWindows == Drivers::St7789::maxWindows) {
+      SendWindows();
+    }
+    windows[nbWindows++] = {x, y, width, height};
+  };
+
+  for (size_t i = 0; i < count; i++) {
+    const lv_area_t& area = areas[i];
+    uint16_t width = lv_area_get_width(&area);
+    uint16_t height = lv_area_get_height(&area);
+    uint16_t y1 = (area.y1 + writeOffset) % totalNbLines;
+    uint16_t y2 = (area.y2 + writeOffset) % totalNbLines;
+    // Areas crossing the end of the frame memory are split in two windows
+    if (y2 < y1) {
+      AddWindow(area.x1, y1, width, totalNbLines - y1);
+      AddWindow(area.x1, 0, width, y2 + 1);
+    } else {
+      AddWindow(area.x1, y1, width, height);
+    }
+    flushStatistics.bytesSent += lv_area_get_size(&area) * sizeof(lv_color_t);
+  }
+
+  if (nbWindows > 0) {
+    SendWindows();
+  }
+}
+
+void LittleVgl::OnRefreshFinished(uint32_t renderTimeMs, uint32_t renderedPixels) {
+  frameStatistics.frames++;
+  frameStatistics.lastRenderTimeMs = renderTimeMs;
+  frameStatistics.lastRenderedPixels = renderedPixels;
+  frameStatistics.lastFlushedPixels = frameFlushedPixels;
+  frameStatistics.lastDrawBufferCalls = frameDrawBufferCalls;
+  if (renderTimeMs > frameStatistics.maxRenderTimeMs) {
+    frameStatistics.maxRenderTimeMs = renderTimeMs;
+  }
+  frameStatistics.totalRenderTimeMs += renderTimeMs;
+  frameStatistics.totalFlushedPixels += frameFlushedPixels;
+  frameStatistics.totalDrawBufferCalls += frameDrawBufferCalls;
+
+  frameFlushedPixels = 0;
+  frameDrawBufferCalls = 0;
+
+  // The new screen is fully drawn once the full refresh was done and the animation reached its end
+  if (isTransitionRunning && !fullRefresh && scrollDirection == FullRefreshDirections::None) {
+    EndTransition();
+  }
+}
+
+void LittleVgl::EndTransition() {
+  isTransitionRunning = false;
+  uint32_t durationMs = (xTaskGetTickCount() - transitionStart) * 1000 / configTICK_RATE_HZ;
+  transitionStatistics.transitions++;
+  transitionStatistics.lastDurationMs = durationMs;
+  transitionStatistics.lastFrames = transitionFrames;
+  if (durationMs > transitionStatistics.maxDurationMs) {
+    transitionStatistics.maxDurationMs = durationMs;
+  }
+  if (durationMs > transitionBudgetMs) {
+    transitionStatistics.overBudget++;
+    NRF_LOG_INFO("[LVGL] Transition took %d ms (%d frames)", durationMs, transitionFrames);
+  }
+}
+
+uint32_t LittleVgl::GetLastTransitionFrameRate() const {
+  if (transitionStatistics.lastDurationMs == 0) {
+    return 0;
+  }
+  return transitionStatistics.lastFrames * 1000 / transitionStatistics.lastDurationMs;
+}
+
+void LittleVgl::CoalesceInvalidAreas(lv_disp_t* disp) {
+  for (uint32_t i = 0; i < disp->inv_p; i++) {
+    if (disp->inv_area_joined[i] != 0) {
+      continue;
+    }
+
+    bool merged;
+    do {
+      merged = false;
+      for (uint32_t j = 0; j < disp->inv_p; j++) {
+        if (j == i || disp->inv_area_joined[j] != 0) {
+          continue;
+        }
+
+        lv_area_t joined;
+        _lv_area_join(&joined, &disp->inv_areas[i], &disp->inv_areas[j]);
+        uint32_t separateSize = lv_area_get_size(&disp->inv_areas[i]) + lv_area_get_size(&disp->inv_areas[j]);
+        if (lv_area_get_size(&joined) <= separateSize + areaOverheadPixels) {
+          disp->inv_areas[i] = joined;
+          disp->inv_area_joined[j] = 1;
+          flushStatistics.areasMerged++;
+          merged = true;
+        }
+      }
+    } while (merged);
+  }
+}
+
+void LittleVgl::ClipInvalidAreas(lv_disp_t* disp) {
+  if (!isRefreshClipped) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < disp->inv_p; i++) {
+    if (disp->inv_area_joined[i] == 0 && !_lv_area_intersect(&disp->inv_areas[i], &disp->inv_areas[i], &refreshClip)) {
+      disp->inv_area_joined[i] = 1;
+    }
+  }
+}
+
+void LittleVgl::SetRefreshClip(lv_coord_t y1, lv_coord_t y2) {
+  refreshClip.x1 = 0;
+  refreshClip.y1 = y1;
+  refreshClip.x2 = LV_HOR_RES - 1;
+  refreshClip.y2 = y2;
+  isRefreshClipped = true;
+}
+
+void LittleVgl::ClearRefreshClip() {
+  isRefreshClipped = false;
+}
+
+void LittleVgl::RefreshNow() {
+  lv_disp_t* disp = lv_disp_get_default();
+  refresh_task(disp->refr_task);
+}
+
+void LittleVgl::EnableImageCache(bool enable) {
+  if (enable) {
+    imageCache.SetBudget(imageCacheBudget);
+    return;
+  }
+  lv_img_cache_invalidate_src(nullptr);
+  imageCache.SetBudget(0);
+}
+
+void LittleVgl::WaitForFlush() {
+  // The notification is given when the transfer ends, give it back for the next flush
+  ulTaskNotifyTake(pdTRUE, 200);
+  xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+}
+
+void LittleVgl::SetRefreshPeriod(uint32_t periodMs) {
+  lv_disp_t* disp = lv_disp_get_default();
+  lv_task_set_period(disp->refr_task, periodMs);
+}
+
 void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
+  isTouchPointRead = false;
   if (contact) {
     if (!isCancelled) {
       touchPoint = {x, y};
@@ -261,6 +454,7 @@ void LittleVgl::CancelTap() {
 }
 
 bool LittleVgl::GetTouchPadInfo(lv_indev_data_t* ptr) {
+  isTouchPointRead = true;
   ptr->point.x = touchPoint.x;
   ptr->point.y = touchPoint.y;
   if (tapped) {
@@ -270,3 +464,8 @@ bool LittleVgl::GetTouchPadInfo(lv_indev_data_t* ptr) {
   }
   return false;
 }
+
+bool LittleVgl::IsIdle() const {
+  const lv_disp_t* disp = lv_disp_get_default();
+  return disp->inv_p == 0 && lv_anim_count_running() == 0 && !tapped && isTouchPointRead;
+}
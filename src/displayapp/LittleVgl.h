@@ -1,7 +1,9 @@
 #pragma once
 
+#include <FreeRTOS.h>
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "displayapp/ImageCache.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -12,6 +14,45 @@ namespace Pinetime {
     class LittleVgl {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
+
+      // Render cost of the lvgl refresh passes, used to track per-screen rendering regressions.
+      // "last*" fields describe the most recent refresh pass, "total*" fields accumulate since the last reset.
+      struct FrameStatistics {
+        uint32_t frames = 0;
+        uint32_t lastRenderTimeMs = 0;
+        uint32_t lastRenderedPixels = 0;
+        uint32_t lastFlushedPixels = 0;
+        uint16_t lastDrawBufferCalls = 0;
+        uint32_t maxRenderTimeMs = 0;
+        uint32_t totalRenderTimeMs = 0;
+        uint32_t totalFlushedPixels = 0;
+        uint32_t totalDrawBufferCalls = 0;
+      };
+
+      struct FlushStatistics {
+        uint32_t flushes = 0;
+        uint32_t areasMerged = 0;
+        uint32_t bytesSent = 0;
+        // Time between the call to FlushDisplay() and the start of its first SPI transfer, spent waiting for the
+        // transfer of the previous flush to end
+        uint32_t totalFlushLatencyMs = 0;
+        uint32_t maxFlushLatencyMs = 0;
+      };
+
+      // Full screen transitions, from SetFullRefresh() with a direction to the end of the refresh pass drawing the new screen.
+      // Each flush during a transition shows a new step of the scroll or wipe animation.
+      struct TransitionStatistics {
+        uint32_t transitions = 0;
+        uint32_t lastDurationMs = 0;
+        uint32_t maxDurationMs = 0;
+        uint32_t lastFrames = 0;
+        // Transitions which took longer than transitionBudgetMs
+        uint32_t overBudget = 0;
+      };
+
+      // Above this duration, a screen switch does not feel immediate anymore
+      static constexpr uint32_t transitionBudgetMs = 250;
+
       LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem);
 
       LittleVgl(const LittleVgl&) = delete;
@@ -22,11 +63,64 @@ namespace Pinetime {
       void Init();
 
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
+      // Draw the areas in a single colour, outside of lvgl. color_p must hold at least the pixels of the largest area.
+      // The areas are sent in batches of chained transfers instead of one transfer per area.
+      void FillAreas(const lv_area_t* areas, size_t count, const lv_color_t* color_p);
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
       void CancelTap();
 
+      // True when lvgl has nothing to draw, no animation running and no touch to process: its display and input
+      // tasks, which run every LV_DISP_DEF_REFR_PERIOD, do not need to run until something changes.
+      bool IsIdle() const;
+
+      void OnRefreshFinished(uint32_t renderTimeMs, uint32_t renderedPixels);
+      void CoalesceInvalidAreas(lv_disp_t* disp);
+      void ClipInvalidAreas(lv_disp_t* disp);
+
+      // Restrict the refresh to the lines y1 to y2, invalid areas outside of them are dropped.
+      // Invalidate the whole screen after clearing the clip to redraw what was dropped.
+      void SetRefreshClip(lv_coord_t y1, lv_coord_t y2);
+      void ClearRefreshClip();
+      // Refresh the invalid areas immediately instead of waiting for the next refresh period
+      void RefreshNow();
+      // Block until the transfer of the last flush has ended, before sending commands to the display
+      void WaitForFlush();
+      // Period of the display refresh task, LV_DISP_DEF_REFR_PERIOD by default
+      void SetRefreshPeriod(uint32_t periodMs);
+
+      const FrameStatistics& GetFrameStatistics() const {
+        return frameStatistics;
+      }
+
+      void ResetFrameStatistics() {
+        frameStatistics = {};
+      }
+
+      const FlushStatistics& GetFlushStatistics() const {
+        return flushStatistics;
+      }
+
+      void ResetFlushStatistics() {
+        flushStatistics = {};
+      }
+
+      const TransitionStatistics& GetTransitionStatistics() const {
+        return transitionStatistics;
+      }
+
+      // Animation steps per second of the last transition
+      uint32_t GetLastTransitionFrameRate() const;
+
+      ImageCache& GetImageCache() {
+        return imageCache;
+      }
+
+      // Images are only kept in RAM for the screens which enable the cache. Disabling it closes the files kept open by
+      // the lvgl image cache and frees the RAM used by the images of the previous screen.
+      void EnableImageCache(bool enable);
+
       bool GetFullRefresh() {
         bool returnValue = fullRefresh;
         if (fullRefresh) {
@@ -39,10 +133,16 @@ namespace Pinetime {
       void InitDisplay();
       void InitTouchpad();
       void InitFileSystem();
+      void EndTransition();
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
 
+      // RAM used to keep the images of the filesystem while the cache is enabled, see ImageCache. It fits the images of
+      // the watch faces.
+      static constexpr uint32_t imageCacheBudget = 4096;
+      ImageCache imageCache;
+
       lv_disp_buf_t disp_buf_2;
       lv_color_t buf2_1[LV_HOR_RES_MAX * 4];
       lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
@@ -53,6 +153,9 @@ namespace Pinetime {
       static constexpr uint8_t nbWriteLines = 4;
       static constexpr uint16_t totalNbLines = 320;
       static constexpr uint16_t visibleNbLines = 240;
+      // Each flushed area costs a render pass and a SetAddrWindow() sequence. Two invalid areas are merged if
+      // the pixels redrawn needlessly by the merged area cost less than this overhead.
+      static constexpr uint32_t areaOverheadPixels = LV_HOR_RES_MAX;
 
       static constexpr uint8_t MaxScrollOffset() {
         return LV_VER_RES_MAX - nbWriteLines;
@@ -62,9 +165,22 @@ namespace Pinetime {
       uint16_t writeOffset = 0;
       uint16_t scrollOffset = 0;
 
+      bool isRefreshClipped = false;
+      lv_area_t refreshClip;
+
+      FrameStatistics frameStatistics;
+      FlushStatistics flushStatistics;
+      TransitionStatistics transitionStatistics;
+      bool isTransitionRunning = false;
+      TickType_t transitionStart = 0;
+      uint32_t transitionFrames = 0;
+      uint32_t frameFlushedPixels = 0;
+      uint16_t frameDrawBufferCalls = 0;
+
       lv_point_t touchPoint = {};
       bool tapped = false;
       bool isCancelled = false;
+      bool isTouchPointRead = true;
     };
   }
 }
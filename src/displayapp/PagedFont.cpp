@@ -0,0 +1,372 @@
+#include "displayapp/PagedFont.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Reads the bit packed fields of the glyph headers, most significant bit first
+  class BitReader {
+  public:
+    explicit BitReader(const uint8_t* data) : data {data} {
+    }
+
+    uint32_t Read(uint8_t nbBits) {
+      uint32_t value = 0;
+      while (nbBits-- > 0) {
+        uint8_t bit = (data[position / 8] >> (7 - (position % 8))) & 0x01;
+        value = (value << 1) | bit;
+        position++;
+      }
+      return value;
+    }
+
+    int32_t ReadSigned(uint8_t nbBits) {
+      uint32_t value = Read(nbBits);
+      if (nbBits > 0 && (value & (1u << (nbBits - 1))) != 0) {
+        value |= ~0u << nbBits;
+      }
+      return static_cast<int32_t>(value);
+    }
+
+  private:
+    const uint8_t* data;
+    uint32_t position = 0;
+  };
+}
+
+PagedFont::PagedFont(Pinetime::Controllers::FS& filesystem) : filesystem {filesystem} {
+}
+
+PagedFont::~PagedFont() {
+  Close();
+}
+
+lv_font_t* PagedFont::Load(const char* path, uint8_t cacheSize) {
+  Close();
+  if (cacheSize == 0) {
+    return nullptr;
+  }
+  // Glyphs are read on each draw, read them from the resource pack when possible
+  isPacked = filesystem.GetResourcePack().Find(path, asset);
+  if (!isPacked && filesystem.FileOpen(&file, path, LFS_O_RDONLY) < 0) {
+    return nullptr;
+  }
+  isOpen = true;
+  position = 0;
+
+  uint32_t headLength;
+  if (!ReadSection(0, "head", headLength) ||
+      !ReadFile(reinterpret_cast<uint8_t*>(&header), sizeof(header))) {
+    Close();
+    return nullptr;
+  }
+
+  // Compressed bitmaps would have to be decompressed on each access
+  if (header.compressionId != 0 || header.indexToLocFormat > 1 ||
+      (header.bitsPerPixel != 1 && header.bitsPerPixel != 2 && header.bitsPerPixel != 4 && header.bitsPerPixel != 8)) {
+    Close();
+    return nullptr;
+  }
+
+  uint32_t cmapOffset = headLength;
+  uint32_t cmapLength;
+  if (!ReadSection(cmapOffset, "cmap", cmapLength) || !LoadCmaps(cmapOffset)) {
+    Close();
+    return nullptr;
+  }
+
+  uint32_t locaOffset = cmapOffset + cmapLength;
+  uint32_t locaLength;
+  if (!ReadSection(locaOffset, "loca", locaLength) || !LoadLoca(header.indexToLocFormat)) {
+    Close();
+    return nullptr;
+  }
+
+  glyfOffset = locaOffset + locaLength;
+  if (!ReadSection(glyfOffset, "glyf", glyfLength) || nbGlyphs == 0) {
+    Close();
+    return nullptr;
+  }
+
+  // Every slot can hold the largest glyph
+  slotSize = 0;
+  for (uint32_t i = 0; i < nbGlyphs; i++) {
+    uint32_t next = (i < nbGlyphs - 1) ? glyphOffsets[i + 1] : glyfLength;
+    if (next > glyphOffsets[i]) {
+      slotSize = std::max(slotSize, next - glyphOffsets[i]);
+    }
+  }
+
+  nbSlots = cacheSize;
+  slots = std::make_unique<Slot[]>(nbSlots);
+  bitmaps = std::make_unique<uint8_t[]>(nbSlots * slotSize);
+  for (uint8_t i = 0; i < nbSlots; i++) {
+    slots[i].bitmap = &bitmaps[i * slotSize];
+  }
+
+  font = {};
+  font.get_glyph_dsc = GetGlyphDsc;
+  font.get_glyph_bitmap = GetGlyphBitmap;
+  font.line_height = header.ascent - header.descent;
+  font.base_line = -header.descent;
+  font.subpx = header.subpixelsMode;
+  font.dsc = this;
+  return &font;
+}
+
+void PagedFont::Close() {
+  if (isOpen && !isPacked) {
+    filesystem.FileClose(&file);
+  }
+  isOpen = false;
+  isPacked = false;
+  nbCmaps = 0;
+  cmaps.reset();
+  nbGlyphs = 0;
+  glyphOffsets.reset();
+  nbSlots = 0;
+  slots.reset();
+  bitmaps.reset();
+}
+
+bool PagedFont::SeekFile(uint32_t offset) {
+  if (isPacked) {
+    position = offset;
+    return true;
+  }
+  return filesystem.FileSeek(&file, offset) >= 0;
+}
+
+bool PagedFont::ReadFile(uint8_t* buffer, uint32_t size) {
+  if (isPacked) {
+    uint32_t read = filesystem.GetResourcePack().Read(asset, position, buffer, size);
+    position += read;
+    return read == size;
+  }
+  return filesystem.FileRead(&file, buffer, size) == static_cast<int>(size);
+}
+
+bool PagedFont::ReadSection(uint32_t offset, const char* label, uint32_t& length) {
+  char sectionLabel[4];
+  if (!SeekFile(offset) ||
+      !ReadFile(reinterpret_cast<uint8_t*>(&length), sizeof(length)) ||
+      !ReadFile(reinterpret_cast<uint8_t*>(sectionLabel), sizeof(sectionLabel))) {
+    return false;
+  }
+  return std::memcmp(sectionLabel, label, sizeof(sectionLabel)) == 0;
+}
+
+bool PagedFont::LoadCmaps(uint32_t offset) {
+  if (!ReadFile(reinterpret_cast<uint8_t*>(&nbCmaps), sizeof(nbCmaps))) {
+    return false;
+  }
+
+  auto tables = std::make_unique<CmapTable[]>(nbCmaps);
+  int tablesSize = nbCmaps * sizeof(CmapTable);
+  if (!ReadFile(reinterpret_cast<uint8_t*>(tables.get()), tablesSize)) {
+    return false;
+  }
+
+  cmaps = std::make_unique<Cmap[]>(nbCmaps);
+  for (uint32_t i = 0; i < nbCmaps; i++) {
+    Cmap& cmap = cmaps[i];
+    cmap.rangeStart = tables[i].rangeStart;
+    cmap.rangeLength = tables[i].rangeLength;
+    cmap.glyphIdStart = tables[i].glyphIdStart;
+    cmap.listLength = tables[i].dataEntriesCount;
+    cmap.type = static_cast<CmapTypes>(tables[i].formatType);
+
+    if (!SeekFile(offset + tables[i].dataOffset)) {
+      return false;
+    }
+
+    int size;
+    switch (cmap.type) {
+      case CmapTypes::Format0Full:
+        size = cmap.listLength;
+        cmap.glyphIdOffsets = std::make_unique<uint8_t[]>(size);
+        if (!ReadFile(cmap.glyphIdOffsets.get(), size)) {
+          return false;
+        }
+        break;
+      case CmapTypes::SparseFull:
+      case CmapTypes::SparseTiny:
+        size = cmap.listLength * sizeof(uint16_t);
+        cmap.unicodeList = std::make_unique<uint16_t[]>(cmap.listLength);
+        if (!ReadFile(reinterpret_cast<uint8_t*>(cmap.unicodeList.get()), size)) {
+          return false;
+        }
+        if (cmap.type == CmapTypes::SparseFull) {
+          cmap.glyphIdOffsets = std::make_unique<uint8_t[]>(size);
+          if (!ReadFile(cmap.glyphIdOffsets.get(), size)) {
+            return false;
+          }
+        }
+        break;
+      case CmapTypes::Format0Tiny:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool PagedFont::LoadLoca(uint8_t indexToLocFormat) {
+  if (!ReadFile(reinterpret_cast<uint8_t*>(&nbGlyphs), sizeof(nbGlyphs))) {
+    return false;
+  }
+
+  glyphOffsets = std::make_unique<uint32_t[]>(nbGlyphs);
+  auto* raw = reinterpret_cast<uint8_t*>(glyphOffsets.get());
+  int entrySize = (indexToLocFormat == 0) ? sizeof(uint16_t) : sizeof(uint32_t);
+  int size = nbGlyphs * entrySize;
+  if (!ReadFile(raw, size)) {
+    return false;
+  }
+
+  if (indexToLocFormat == 0) {
+    // Widen the 16 bits offsets in place, starting from the end so that no entry is overwritten before it is read
+    for (uint32_t i = nbGlyphs; i > 0; i--) {
+      uint16_t glyphOffset;
+      std::memcpy(&glyphOffset, &raw[(i - 1) * sizeof(uint16_t)], sizeof(uint16_t));
+      glyphOffsets[i - 1] = glyphOffset;
+    }
+  }
+  return true;
+}
+
+uint32_t PagedFont::GetGlyphId(uint32_t letter) const {
+  for (uint32_t i = 0; i < nbCmaps; i++) {
+    const Cmap& cmap = cmaps[i];
+    uint32_t rcp = letter - cmap.rangeStart;
+    if (letter < cmap.rangeStart || rcp >= cmap.rangeLength) {
+      continue;
+    }
+
+    switch (cmap.type) {
+      case CmapTypes::Format0Tiny:
+        return cmap.glyphIdStart + rcp;
+      case CmapTypes::Format0Full:
+        return cmap.glyphIdStart + cmap.glyphIdOffsets[rcp];
+      case CmapTypes::SparseTiny:
+      case CmapTypes::SparseFull: {
+        const uint16_t* begin = cmap.unicodeList.get();
+        const uint16_t* end = begin + cmap.listLength;
+        const uint16_t* found = std::lower_bound(begin, end, rcp);
+        if (found == end || *found != rcp) {
+          return 0;
+        }
+        uint32_t index = found - begin;
+        if (cmap.type == CmapTypes::SparseTiny) {
+          return cmap.glyphIdStart + index;
+        }
+        uint16_t glyphIdOffset;
+        std::memcpy(&glyphIdOffset, &cmap.glyphIdOffsets[index * sizeof(uint16_t)], sizeof(uint16_t));
+        return cmap.glyphIdStart + glyphIdOffset;
+      }
+    }
+  }
+  return 0;
+}
+
+PagedFont::Slot* PagedFont::GetGlyph(uint32_t letter) {
+  uint32_t glyphId = GetGlyphId(letter);
+  // Glyph 0 is reserved by the font format
+  if (glyphId == 0 || glyphId >= nbGlyphs) {
+    return nullptr;
+  }
+
+  useCounter++;
+  Slot* leastRecentlyUsed = &slots[0];
+  for (uint8_t i = 0; i < nbSlots; i++) {
+    if (slots[i].glyphId == glyphId) {
+      slots[i].lastUse = useCounter;
+      statistics.hits++;
+      return &slots[i];
+    }
+    if (slots[i].lastUse < leastRecentlyUsed->lastUse) {
+      leastRecentlyUsed = &slots[i];
+    }
+  }
+
+  statistics.misses++;
+  if (!ReadGlyph(glyphId, *leastRecentlyUsed)) {
+    statistics.readErrors++;
+    leastRecentlyUsed->glyphId = 0;
+    leastRecentlyUsed->lastUse = 0;
+    return nullptr;
+  }
+  leastRecentlyUsed->glyphId = glyphId;
+  leastRecentlyUsed->lastUse = useCounter;
+  return leastRecentlyUsed;
+}
+
+bool PagedFont::ReadGlyph(uint32_t glyphId, Slot& slot) {
+  uint32_t offset = glyphOffsets[glyphId];
+  uint32_t next = (glyphId < nbGlyphs - 1) ? glyphOffsets[glyphId + 1] : glyfLength;
+  if (next < offset || next - offset > slotSize) {
+    return false;
+  }
+
+  int size = next - offset;
+  if (!SeekFile(glyfOffset + offset) || !ReadFile(slot.bitmap, size)) {
+    return false;
+  }
+
+  BitReader reader(slot.bitmap);
+  uint32_t advanceWidth = (header.advanceWidthBits == 0) ? header.defaultAdvanceWidth : reader.Read(header.advanceWidthBits);
+  if (header.advanceWidthFormat == 0) {
+    advanceWidth *= 16;
+  }
+  slot.dsc.ofs_x = reader.ReadSigned(header.xyBits);
+  slot.dsc.ofs_y = reader.ReadSigned(header.xyBits);
+  slot.dsc.box_w = reader.Read(header.whBits);
+  slot.dsc.box_h = reader.Read(header.whBits);
+  // Advance widths are stored in 1/16 pixels
+  slot.dsc.adv_w = (advanceWidth + (1 << 3)) >> 4;
+  slot.dsc.bpp = header.bitsPerPixel;
+
+  // Move the bitmap, which follows the header without byte alignment, to the beginning of the slot
+  uint32_t headerBits = header.advanceWidthBits + 2 * header.xyBits + 2 * header.whBits;
+  uint32_t headerBytes = headerBits / 8;
+  uint8_t shift = headerBits % 8;
+  if (static_cast<uint32_t>(size) <= headerBytes) {
+    return true;
+  }
+  uint32_t bitmapSize = size - headerBytes;
+  if (shift == 0) {
+    std::memmove(slot.bitmap, &slot.bitmap[headerBytes], bitmapSize);
+  } else {
+    for (uint32_t i = 0; i < bitmapSize - 1; i++) {
+      slot.bitmap[i] = (slot.bitmap[headerBytes + i] << shift) | (slot.bitmap[headerBytes + i + 1] >> (8 - shift));
+    }
+    slot.bitmap[bitmapSize - 1] = slot.bitmap[headerBytes + bitmapSize - 1] << shift;
+  }
+  return true;
+}
+
+bool PagedFont::GetGlyphDsc(const lv_font_t* font, lv_font_glyph_dsc_t* dsc, uint32_t letter, uint32_t /*letterNext*/) {
+  auto* pagedFont = static_cast<PagedFont*>(font->dsc);
+  bool isTab = (letter == '\t');
+  Slot* slot = pagedFont->GetGlyph(isTab ? ' ' : letter);
+  if (slot == nullptr) {
+    return false;
+  }
+
+  *dsc = slot->dsc;
+  if (isTab) {
+    dsc->adv_w *= 2;
+  }
+  return true;
+}
+
+const uint8_t* PagedFont::GetGlyphBitmap(const lv_font_t* font, uint32_t letter) {
+  auto* pagedFont = static_cast<PagedFont*>(font->dsc);
+  Slot* slot = pagedFont->GetGlyph(letter == '\t' ? ' ' : letter);
+  if (slot == nullptr) {
+    return nullptr;
+  }
+  return slot->bitmap;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <lvgl/lvgl.h>
+#include "components/fs/FS.h"
+
+namespace Pinetime {
+  namespace Components {
+    /* Loader for lvgl binary fonts (as generated by lv_font_conv --format bin) stored in the filesystem or in the
+     * resource pack.
+     * Unlike lv_font_load(), which loads the whole font in the lvgl heap, only the character map and the glyph
+     * offsets are kept in memory. Glyphs are read from the file when they are drawn and kept in a small LRU cache.
+     *
+     * Compressed fonts are not supported. The kerning table, if any, is not read: the next letter given by lvgl is
+     * ignored and glyphs are always spaced by their advance width, so kerned pairs are drawn further apart than
+     * with the built-in fonts. Fonts meant for this loader are generated with --no-kerning (see generate-fonts.py).
+     */
+    class PagedFont {
+    public:
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t readErrors = 0;
+      };
+
+      explicit PagedFont(Pinetime::Controllers::FS& filesystem);
+      ~PagedFont();
+
+      PagedFont(const PagedFont&) = delete;
+      PagedFont& operator=(const PagedFont&) = delete;
+      PagedFont(PagedFont&&) = delete;
+      PagedFont& operator=(PagedFont&&) = delete;
+
+      // Open the font at path (without the lvgl drive letter). cacheSize glyphs are kept in memory, it should be at least
+      // the number of different glyphs drawn on the same lines to avoid reading them again for each part of the screen.
+      // Returns nullptr if the font cannot be loaded.
+      lv_font_t* Load(const char* path, uint8_t cacheSize);
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+    private:
+      // Binary layout of the font header and of the character map descriptions, as written by lv_font_conv
+      struct FontHeader {
+        uint32_t version;
+        uint16_t tablesCount;
+        uint16_t fontSize;
+        uint16_t ascent;
+        int16_t descent;
+        uint16_t typoAscent;
+        int16_t typoDescent;
+        uint16_t typoLineGap;
+        int16_t minY;
+        int16_t maxY;
+        uint16_t defaultAdvanceWidth;
+        uint16_t kerningScale;
+        uint8_t indexToLocFormat;
+        uint8_t glyphIdFormat;
+        uint8_t advanceWidthFormat;
+        uint8_t bitsPerPixel;
+        uint8_t xyBits;
+        uint8_t whBits;
+        uint8_t advanceWidthBits;
+        uint8_t compressionId;
+        uint8_t subpixelsMode;
+        uint8_t padding;
+      };
+
+      struct CmapTable {
+        uint32_t dataOffset;
+        uint32_t rangeStart;
+        uint16_t rangeLength;
+        uint16_t glyphIdStart;
+        uint16_t dataEntriesCount;
+        uint8_t formatType;
+        uint8_t padding;
+      };
+
+      enum class CmapTypes : uint8_t { Format0Full = 0, SparseFull = 1, Format0Tiny = 2, SparseTiny = 3 };
+
+      struct Cmap {
+        uint32_t rangeStart;
+        uint16_t rangeLength;
+        uint16_t glyphIdStart;
+        uint16_t listLength;
+        CmapTypes type;
+        std::unique_ptr<uint16_t[]> unicodeList;
+        // uint8_t offsets for Format0Full, uint16_t offsets for SparseFull
+        std::unique_ptr<uint8_t[]> glyphIdOffsets;
+      };
+
+      struct Slot {
+        uint32_t glyphId = 0;
+        uint32_t lastUse = 0;
+        lv_font_glyph_dsc_t dsc;
+        uint8_t* bitmap;
+      };
+
+      static bool GetGlyphDsc(const lv_font_t* font, lv_font_glyph_dsc_t* dsc, uint32_t letter, uint32_t letterNext);
+      static const uint8_t* GetGlyphBitmap(const lv_font_t* font, uint32_t letter);
+
+      bool SeekFile(uint32_t offset);
+      bool ReadFile(uint8_t* buffer, uint32_t size);
+      bool ReadSection(uint32_t offset, const char* label, uint32_t& length);
+      bool LoadCmaps(uint32_t offset);
+      bool LoadLoca(uint8_t indexToLocFormat);
+      uint32_t GetGlyphId(uint32_t letter) const;
+      Slot* GetGlyph(uint32_t letter);
+      bool ReadGlyph(uint32_t glyphId, Slot& slot);
+      void Close();
+
+      Pinetime::Controllers::FS& filesystem;
+      lfs_file_t file;
+      bool isOpen = false;
+      // The font is read from the resource pack instead of file
+      bool isPacked = false;
+      Pinetime::Controllers::ResourcePack::Asset asset;
+      uint32_t position = 0;
+
+      lv_font_t font;
+      FontHeader header;
+
+      uint32_t nbCmaps = 0;
+      std::unique_ptr<Cmap[]> cmaps;
+
+      uint32_t nbGlyphs = 0;
+      uint32_t glyfOffset = 0;
+      uint32_t glyfLength = 0;
+      std::unique_ptr<uint32_t[]> glyphOffsets;
+
+      uint8_t nbSlots = 0;
+      uint32_t slotSize = 0;
+      uint32_t useCounter = 0;
+      std::unique_ptr<Slot[]> slots;
+      std::unique_ptr<uint8_t[]> bitmaps;
+
+      Statistics statistics;
+    };
+  }
+}
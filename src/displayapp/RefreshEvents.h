@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Applications {
+
+    // Changes of the controllers that trigger the refresh of a screen, see RefreshScheduler
+    enum class RefreshEvents : uint8_t {
+      None = 0,
+      Second = 1 << 0,
+      Minute = 1 << 1,
+      Battery = 1 << 2,
+      Ble = 1 << 3,
+      HeartRate = 1 << 4,
+      Motion = 1 << 5,
+      Notifications = 1 << 6,
+      // Refresh periodically, for screens showing animations or data without change events
+      Frame = 1 << 7,
+    };
+
+    constexpr RefreshEvents operator|(RefreshEvents lhs, RefreshEvents rhs) {
+      return static_cast<RefreshEvents>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs));
+    }
+
+    constexpr RefreshEvents operator&(RefreshEvents lhs, RefreshEvents rhs) {
+      return static_cast<RefreshEvents>(static_cast<uint8_t>(lhs) & static_cast<uint8_t>(rhs));
+    }
+
+    constexpr bool Any(RefreshEvents events) {
+      return events != RefreshEvents::None;
+    }
+  }
+}
@@ -0,0 +1,103 @@
+#include "displayapp/RefreshScheduler.h"
+#include <task.h>
+#include <algorithm>
+#include "components/battery/BatteryController.h"
+#include "components/ble/BleController.h"
+#include "components/ble/NotificationManager.h"
+#include "components/datetime/DateTimeController.h"
+#include "components/motion/MotionController.h"
+#include "displayapp/screens/Screen.h"
+
+using namespace Pinetime::Applications;
+
+RefreshScheduler::RefreshScheduler(Controllers::DateTime& dateTimeController,
+                                   const Controllers::Battery& batteryController,
+                                   const Controllers::Ble& bleController,
+                                   Controllers::HeartRateController& heartRateController,
+                                   Controllers::MotionController& motionController,
+                                   Controllers::NotificationManager& notificationManager)
+  : dateTimeController {dateTimeController},
+    batteryController {batteryController},
+    bleController {bleController},
+    heartRateController {heartRateController},
+    motionController {motionController},
+    notificationManager {notificationManager} {
+}
+
+TickType_t RefreshScheduler::Run(Screens::Screen& screen) {
+  RefreshEvents changes = Poll();
+  RefreshEvents events = screen.GetRefreshEvents();
+  if (!Any(events)) {
+    currentScreen = nullptr;
+    return portMAX_DELAY;
+  }
+
+  TickType_t now = xTaskGetTickCount();
+  if (&screen != currentScreen) {
+    // Screens refresh themselves when they are created
+    currentScreen = &screen;
+    lastRefresh = now;
+    isRefreshPending = false;
+  }
+
+  if (Any(changes & events) || Any(events & RefreshEvents::Frame)) {
+    isRefreshPending = true;
+  }
+
+  TickType_t period = pdMS_TO_TICKS(screen.GetRefreshPeriod());
+  TickType_t elapsed = now - lastRefresh;
+  if (isRefreshPending) {
+    if (elapsed < period) {
+      return period - elapsed;
+    }
+    screen.OnRefreshEvent();
+    statistics.refreshes++;
+    lastRefresh = now;
+    isRefreshPending = false;
+    elapsed = 0;
+  }
+
+  if (Any(events & RefreshEvents::Frame)) {
+    return period - elapsed;
+  }
+  TickType_t timeout = pollPeriod;
+  if (Any(events & RefreshEvents::Second)) {
+    timeout = std::min(timeout, TicksToNextSecond());
+  }
+  return timeout;
+}
+
+RefreshEvents RefreshScheduler::Poll() {
+  statistics.polls++;
+  RefreshEvents changes = RefreshEvents::None;
+  auto Update = [&changes](auto& value, auto newValue, RefreshEvents event) {
+    if (value != newValue) {
+      value = newValue;
+      changes = changes | event;
+    }
+  };
+
+  Update(seconds, dateTimeController.Seconds(), RefreshEvents::Second);
+  Update(minutes, dateTimeController.Minutes(), RefreshEvents::Minute);
+  Update(batteryPercent, batteryController.PercentRemaining(), RefreshEvents::Battery);
+  Update(isCharging, batteryController.IsCharging(), RefreshEvents::Battery);
+  Update(isPowerPresent, batteryController.IsPowerPresent(), RefreshEvents::Battery);
+  Update(isBleConnected, bleController.IsConnected(), RefreshEvents::Ble);
+  Update(isBleRadioEnabled, bleController.IsRadioEnabled(), RefreshEvents::Ble);
+  Update(heartRate, heartRateController.HeartRate(), RefreshEvents::HeartRate);
+  Update(heartRateState, heartRateController.State(), RefreshEvents::HeartRate);
+  Update(steps, motionController.NbSteps(), RefreshEvents::Motion);
+  Update(nbNotifications, notificationManager.NbNotifications(), RefreshEvents::Notifications);
+  Update(newNotificationsAvailable, notificationManager.AreNewNotificationsAvailable(), RefreshEvents::Notifications);
+  return changes;
+}
+
+TickType_t RefreshScheduler::TicksToNextSecond() const {
+  auto subSecond = dateTimeController.CurrentDateTime().time_since_epoch() % std::chrono::seconds(1);
+  auto remaining = std::chrono::seconds(1) - std::chrono::duration_cast<std::chrono::milliseconds>(subSecond);
+  TickType_t ticks = pdMS_TO_TICKS(remaining.count());
+  if (ticks < minimumSecondWait) {
+    return minimumSecondWait;
+  }
+  return ticks;
+}
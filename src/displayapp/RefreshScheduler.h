@@ -0,0 +1,84 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <cstddef>
+#include <cstdint>
+#include "displayapp/RefreshEvents.h"
+#include "components/heartrate/HeartRateController.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    class DateTime;
+    class Battery;
+    class Ble;
+    class MotionController;
+    class NotificationManager;
+  }
+
+  namespace Applications {
+    namespace Screens {
+      class Screen;
+    }
+
+    /* Refreshes the current screen when the controllers it displays change, instead of each screen polling them
+     * with its own refresh task. The controllers which do not notify the display task of their changes are polled
+     * at a low rate, so that the display task can sleep between the changes.
+     */
+    class RefreshScheduler {
+    public:
+      struct Statistics {
+        uint32_t polls = 0;
+        uint32_t refreshes = 0;
+      };
+
+      RefreshScheduler(Controllers::DateTime& dateTimeController,
+                       const Controllers::Battery& batteryController,
+                       const Controllers::Ble& bleController,
+                       Controllers::HeartRateController& heartRateController,
+                       Controllers::MotionController& motionController,
+                       Controllers::NotificationManager& notificationManager);
+
+      // Refresh the screen if one of the events it subscribed to occurred.
+      // Returns the number of ticks until the next call, or portMAX_DELAY if the screen did not subscribe to any event.
+      TickType_t Run(Screens::Screen& screen);
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+    private:
+      RefreshEvents Poll();
+      TickType_t TicksToNextSecond() const;
+
+      // Battery, BLE, heart rate, motion and notifications do not notify the display task of their changes
+      static constexpr TickType_t pollPeriod = pdMS_TO_TICKS(250);
+      // The time is updated by the system task every 100ms at most, avoid waking up repeatedly while it is late
+      static constexpr TickType_t minimumSecondWait = pdMS_TO_TICKS(20);
+
+      Controllers::DateTime& dateTimeController;
+      const Controllers::Battery& batteryController;
+      const Controllers::Ble& bleController;
+      Controllers::HeartRateController& heartRateController;
+      Controllers::MotionController& motionController;
+      Controllers::NotificationManager& notificationManager;
+
+      uint8_t seconds = 0;
+      uint8_t minutes = 0;
+      uint8_t batteryPercent = 0;
+      bool isCharging = false;
+      bool isPowerPresent = false;
+      bool isBleConnected = false;
+      bool isBleRadioEnabled = false;
+      uint8_t heartRate = 0;
+      Controllers::HeartRateController::States heartRateState = Controllers::HeartRateController::States::Stopped;
+      uint32_t steps = 0;
+      size_t nbNotifications = 0;
+      bool newNotificationsAvailable = false;
+
+      const Screens::Screen* currentScreen = nullptr;
+      TickType_t lastRefresh = 0;
+      bool isRefreshPending = false;
+      Statistics statistics;
+    };
+  }
+}
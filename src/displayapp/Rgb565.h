@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace Pinetime {
+  namespace Components {
+    /* Blend kernel for the byte swapped RGB565 pixels of the lvgl draw buffer (LV_COLOR_16_SWAP), used as the
+     * gpu_blend_cb of the display driver. It works on raw pixels so that it can be measured against the software
+     * rendering of lvgl on the host, see tools/benchmarks/rgb565.cpp.
+     */
+    namespace Rgb565 {
+      // Swap the bytes of each half-word, which compiles to a single REV16 instruction on the Cortex-M4
+      constexpr uint32_t SwapBytes(uint32_t pixels) {
+        return ((pixels & 0xff00ff00) >> 8) | ((pixels & 0x00ff00ff) << 8);
+      }
+
+      // Spread the channels of a pixel so that they can be multiplied together without overflowing into each other:
+      // green in the upper half-word, red and blue in the lower one.
+      constexpr uint32_t SpreadChannels(uint32_t pixel) {
+        return (pixel | (pixel << 16)) & 0x07e0f81f;
+      }
+
+      constexpr uint16_t PackChannels(uint32_t channels) {
+        channels &= 0x07e0f81f;
+        return static_cast<uint16_t>(channels | (channels >> 16));
+      }
+
+      // Mix two byte swapped pixels, alpha being in the range 0-32
+      inline uint16_t BlendPixel(uint16_t foreground, uint16_t background, uint32_t alpha) {
+        uint32_t fg = SpreadChannels(SwapBytes(foreground));
+        uint32_t bg = SpreadChannels(SwapBytes(background));
+        uint32_t mixed = ((((fg - bg) * alpha) >> 5) + bg);
+        return static_cast<uint16_t>(SwapBytes(PackChannels(mixed)));
+      }
+
+      // Mix src over dest with an lvgl opacity (0-255)
+      inline void BlendPixels(uint16_t* dest, const uint16_t* src, uint32_t length, uint8_t opa) {
+        // 5 bits are enough for the RGB565 channels and keep the products within 32 bits
+        uint32_t alpha = (opa + 4) >> 3;
+        if (alpha == 0) {
+          return;
+        }
+        if (alpha >= 32) {
+          std::memcpy(dest, src, length * sizeof(uint16_t));
+          return;
+        }
+        for (uint32_t i = 0; i < length; i++) {
+          dest[i] = BlendPixel(src[i], dest[i], alpha);
+        }
+      }
+    }
+  }
+}
@@ -57,12 +57,18 @@ Clock::Clock(Controllers::DateTime& dateTimeController,
       return WatchFaceDigitalScreen();
     }()} {
   settingsController.SetAppMenu(0);
+  // Refresh the watch face on the events it subscribed to
+  SubscribeRefresh(screen->GetRefreshEvents(), screen->GetRefreshPeriod());
 }
 
 Clock::~Clock() {
   lv_obj_clean(lv_scr_act());
 }
 
+void Clock::Refresh() {
+  screen->OnRefreshEvent();
+}
+
 bool Clock::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
   return screen->OnTouchEvent(event);
 }
@@ -35,6 +35,8 @@ namespace Pinetime {
         bool OnButtonPushed() override;
 
       private:
+        void Refresh() override;
+
         Controllers::DateTime& dateTimeController;
         const Controllers::Battery& batteryController;
         const Controllers::Ble& bleController;
@@ -4,6 +4,8 @@
 #include "displayapp/InfiniTimeTheme.h"
 
 #include <algorithm> // std::fill
+#include <cstdlib>
+#include <libraries/log/nrf_log.h>
 
 using namespace Pinetime::Applications::Screens;
 
@@ -61,12 +63,49 @@ bool InfiniPaint::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
 }
 
 bool InfiniPaint::OnTouchEvent(uint16_t x, uint16_t y) {
-  lv_area_t area;
-  area.x1 = x - (width / 2);
-  area.y1 = y - (height / 2);
-  area.x2 = x + (width / 2) - 1;
-  area.y2 = y + (height / 2) - 1;
+  TickType_t now = xTaskGetTickCount();
+  lv_point_t point {static_cast<lv_coord_t>(x), static_cast<lv_coord_t>(y)};
+  bool isNewStroke = (now - lastSampleTick) > strokeTimeout;
+  lastSampleTick = now;
   lvgl.SetFullRefresh(Components::LittleVgl::FullRefreshDirections::None);
-  lvgl.FlushDisplay(&area, b);
+
+  if (isNewStroke) {
+    if (strokeSamples > 0) {
+      NRF_LOG_INFO("[InfiniPaint] stroke of %d samples, max latency %d ms", strokeSamples, maxStrokeLatency * 1000 / configTICK_RATE_HZ);
+    }
+    strokeSamples = 0;
+    maxStrokeLatency = 0;
+    AddStamp(point);
+  } else {
+    // Interpolate between the previous sample and this one
+    int16_t dx = point.x - lastPoint.x;
+    int16_t dy = point.y - lastPoint.y;
+    int16_t distance = std::max(std::abs(dx), std::abs(dy));
+    int16_t steps = (distance + stampSpacing - 1) / stampSpacing;
+    for (int16_t i = 1; i <= steps; i++) {
+      AddStamp({static_cast<lv_coord_t>(lastPoint.x + dx * i / steps), static_cast<lv_coord_t>(lastPoint.y + dy * i / steps)});
+    }
+  }
+  lastPoint = point;
+  FlushStamps();
+
+  strokeSamples++;
+  maxStrokeLatency = std::max(maxStrokeLatency, xTaskGetTickCount() - now);
   return true;
 }
+
+void InfiniPaint::AddStamp(lv_point_t point) {
+  if (nbStamps == maxStamps) {
+    FlushStamps();
+  }
+  lv_area_t& area = stamps[nbStamps++];
+  area.x1 = std::max<lv_coord_t>(point.x - (width / 2), 0);
+  area.y1 = std::max<lv_coord_t>(point.y - (height / 2), 0);
+  area.x2 = std::min<lv_coord_t>(point.x + (width / 2) - 1, LV_HOR_RES - 1);
+  area.y2 = std::min<lv_coord_t>(point.y + (height / 2) - 1, LV_VER_RES - 1);
+}
+
+void InfiniPaint::FlushStamps() {
+  lvgl.FillAreas(stamps, nbStamps, b);
+  nbStamps = 0;
+}
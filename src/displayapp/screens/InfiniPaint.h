@@ -1,6 +1,8 @@
 #pragma once
 
+#include <FreeRTOS.h>
 #include <lvgl/lvgl.h>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm> // std::fill
 #include "displayapp/screens/Screen.h"
@@ -25,12 +27,30 @@ namespace Pinetime {
         bool OnTouchEvent(uint16_t x, uint16_t y) override;
 
       private:
+        void AddStamp(lv_point_t point);
+        void FlushStamps();
+
         Pinetime::Components::LittleVgl& lvgl;
         Controllers::MotorController& motor;
         static constexpr uint16_t width = 10;
         static constexpr uint16_t height = 10;
         static constexpr uint16_t bufferSize = width * height;
         lv_color_t b[bufferSize];
+
+        // Touch samples are received every few tens of ms: a stroke is drawn by stamping the brush along the segment
+        // between two samples, every half brush size so that fast strokes do not leave gaps.
+        static constexpr uint16_t stampSpacing = width / 2;
+        // No sample for this long means the finger was lifted, and the next sample starts a new stroke
+        static constexpr TickType_t strokeTimeout = pdMS_TO_TICKS(100);
+        static constexpr size_t maxStamps = 16;
+        lv_area_t stamps[maxStamps];
+        size_t nbStamps = 0;
+        lv_point_t lastPoint;
+        TickType_t lastSampleTick = 0;
+
+        // Time between the reception of a touch sample and the moment its stamps are sent to the display
+        uint32_t strokeSamples = 0;
+        TickType_t maxStrokeLatency = 0;
         lv_color_t selectColor = LV_COLOR_WHITE;
         uint8_t color = 2;
       };
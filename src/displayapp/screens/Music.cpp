@@ -140,11 +140,11 @@ Music::Music(Pinetime::Controllers::MusicService& music) : musicService(music) {
 
   musicService.event(Controllers::MusicService::EVENT_MUSIC_OPEN);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  // The disc animation changes every second, the track data is received from the companion app
+  SubscribeRefresh(RefreshEvents::Frame, 250);
 }
 
 Music::~Music() {
-  lv_task_del(taskRefresh);
   lv_style_reset(&btn_style);
   lv_obj_clean(lv_scr_act());
 }
@@ -77,7 +77,6 @@ namespace Pinetime {
 
         bool playing;
 
-        lv_task_t* taskRefresh;
 
         /** Watchapp */
       };
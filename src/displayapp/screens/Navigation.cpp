@@ -162,11 +162,11 @@ Navigation::Navigation(Pinetime::Controllers::NavigationService& nav) : navServi
   lv_bar_set_range(barProgress, 0, 100);
   lv_bar_set_value(barProgress, 0, LV_ANIM_OFF);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  // The navigation data is received from the companion app, which does not send it more than a few times per second
+  SubscribeRefresh(RefreshEvents::Frame, 250);
 }
 
 Navigation::~Navigation() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
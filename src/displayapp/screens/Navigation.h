@@ -49,8 +49,6 @@ namespace Pinetime {
         std::string narrative;
         std::string manDist;
         int progress;
-
-        lv_task_t* taskRefresh;
       };
     }
   }
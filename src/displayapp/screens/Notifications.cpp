@@ -161,6 +161,13 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
     return false;
   }
 
+  // A swipe that scrolled the message does not switch to another notification
+  bool scrolled = scrolledDuringTouch;
+  scrolledDuringTouch = false;
+  if (scrolled && (event == TouchEvents::SwipeUp || event == TouchEvents::SwipeDown)) {
+    return true;
+  }
+
   switch (event) {
     case Pinetime::Applications::TouchEvents::SwipeRight:
       if (validDisplay) {
@@ -237,6 +244,29 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
   }
 }
 
+bool Notifications::OnTouchEvent(uint16_t /*x*/, uint16_t y) {
+  TickType_t now = xTaskGetTickCount();
+  bool isNewTouch = (now - lastTouchTick) > touchReleaseTimeout;
+  lastTouchTick = now;
+
+  if (isNewTouch || currentItem == nullptr || currentItem->ScrollContent() == nullptr) {
+    lastTouchY = y;
+    scrolledDuringTouch = false;
+    return false;
+  }
+
+  lv_coord_t dy = currentItem->ScrollableBy(static_cast<lv_coord_t>(y) - static_cast<lv_coord_t>(lastTouchY));
+  lastTouchY = y;
+  if (dy == 0) {
+    return false;
+  }
+
+  lv_obj_t* content = currentItem->ScrollContent();
+  lv_obj_set_y(content, lv_obj_get_y(content) + dy);
+  scrolledDuringTouch = true;
+  return true;
+}
+
 namespace {
   void CallEventHandler(lv_obj_t* obj, lv_event_t event) {
     auto* item = static_cast<Notifications::NotificationItem*>(obj->user_data);
@@ -310,6 +340,12 @@ Notifications::NotificationItem::NotificationItem(const char* title,
   switch (category) {
     default:
       lv_label_set_text(alert_subject, msg);
+      if (lv_obj_get_height(alert_subject) > lv_obj_get_height(subject_container) - 2 * subjectPadding) {
+        // Position the message manually so that it can be scrolled
+        lv_cont_set_layout(subject_container, LV_LAYOUT_OFF);
+        lv_obj_set_pos(alert_subject, subjectPadding, subjectPadding);
+        scrollContent = alert_subject;
+      }
       break;
     case Controllers::NotificationManager::Categories::IncomingCall: {
       lv_obj_set_height(subject_container, 108);
@@ -351,6 +387,17 @@ Notifications::NotificationItem::NotificationItem(const char* title,
   }
 }
 
+lv_coord_t Notifications::NotificationItem::ScrollableBy(lv_coord_t dy) const {
+  if (scrollContent == nullptr) {
+    return 0;
+  }
+  lv_coord_t y = lv_obj_get_y(scrollContent);
+  lv_coord_t minY = lv_obj_get_height(subject_container) - lv_obj_get_height(scrollContent) - subjectPadding;
+  lv_coord_t maxY = subjectPadding;
+  lv_coord_t newY = std::max(minY, std::min(static_cast<lv_coord_t>(y + dy), maxY));
+  return newY - y;
+}
+
 void Notifications::NotificationItem::OnCallButtonEvent(lv_obj_t* obj, lv_event_t event) {
   if (event != LV_EVENT_CLICKED) {
     return;
@@ -30,6 +30,7 @@ namespace Pinetime {
 
         void Refresh() override;
         bool OnTouchEvent(Pinetime::Applications::TouchEvents event) override;
+        bool OnTouchEvent(uint16_t x, uint16_t y) override;
         void DismissToBlack();
         void OnPreviewInteraction();
         void OnPreviewDismiss();
@@ -53,7 +54,16 @@ namespace Pinetime {
 
           void OnCallButtonEvent(lv_obj_t*, lv_event_t event);
 
+          // Message label that can be scrolled when it does not fit in the screen, nullptr otherwise
+          lv_obj_t* ScrollContent() const {
+            return scrollContent;
+          }
+
+          // Clamp dy to the distance the message can still be scrolled by
+          lv_coord_t ScrollableBy(lv_coord_t dy) const;
+
         private:
+          static constexpr lv_coord_t subjectPadding = 10;
           lv_obj_t* container;
           lv_obj_t* subject_container;
           lv_obj_t* bt_accept;
@@ -62,6 +72,7 @@ namespace Pinetime {
           lv_obj_t* label_accept;
           lv_obj_t* label_mute;
           lv_obj_t* label_reject;
+          lv_obj_t* scrollContent = nullptr;
           Pinetime::Controllers::AlertNotificationService& alertNotificationService;
           Pinetime::Controllers::MotorController& motorController;
 
@@ -89,6 +100,12 @@ namespace Pinetime {
 
         bool dismissingNotification = false;
 
+        // A touch is considered finished when no touch point was received for this long
+        static const TickType_t touchReleaseTimeout = pdMS_TO_TICKS(100);
+        TickType_t lastTouchTick = 0;
+        uint16_t lastTouchY = 0;
+        bool scrolledDuringTouch = false;
+
         lv_task_t* taskRefresh;
       };
     }
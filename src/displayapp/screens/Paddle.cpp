@@ -30,11 +30,10 @@ Paddle::Paddle(Pinetime::Components::LittleVgl& lvgl) : lvgl {lvgl} {
   lv_obj_set_style_local_radius(ball, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_RADIUS_CIRCLE);
   lv_obj_set_size(ball, ballSize, ballSize);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  SubscribeRefresh(RefreshEvents::Frame);
 }
 
 Paddle::~Paddle() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "displayapp/TouchEvents.h"
+#include "displayapp/RefreshEvents.h"
 #include <lvgl/lvgl.h>
 
 namespace Pinetime {
@@ -25,6 +26,19 @@ namespace Pinetime {
           return running;
         }
 
+        RefreshEvents GetRefreshEvents() const {
+          return refreshEvents;
+        }
+
+        uint32_t GetRefreshPeriod() const {
+          return refreshPeriod;
+        }
+
+        // Called by the refresh scheduler of DisplayApp when one of the subscribed events occurred
+        void OnRefreshEvent() {
+          Refresh();
+        }
+
         /** @return false if the button hasn't been handled by the app, true if it has been handled */
         virtual bool OnButtonPushed() {
           return false;
@@ -41,7 +55,18 @@ namespace Pinetime {
         }
 
       protected:
+        // Refresh the screen when one of the events occurs instead of polling the controllers with a refresh task.
+        // The screen is refreshed at most once per period (in ms), and once per period for RefreshEvents::Frame.
+        void SubscribeRefresh(RefreshEvents events, uint32_t period = LV_DISP_DEF_REFR_PERIOD) {
+          refreshEvents = events;
+          refreshPeriod = period;
+        }
+
         bool running = true;
+
+      private:
+        RefreshEvents refreshEvents = RefreshEvents::None;
+        uint32_t refreshPeriod = LV_DISP_DEF_REFR_PERIOD;
       };
     }
   }
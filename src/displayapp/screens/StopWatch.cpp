@@ -74,11 +74,10 @@ StopWatch::StopWatch(System::SystemTask& systemTask) : systemTask {systemTask} {
 
   SetInterfaceStopped();
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  SubscribeRefresh(RefreshEvents::Frame);
 }
 
 StopWatch::~StopWatch() {
-  lv_task_del(taskRefresh);
   systemTask.PushMessage(Pinetime::System::Messages::EnableSleeping);
   lv_obj_clean(lv_scr_act());
 }
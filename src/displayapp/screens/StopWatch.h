@@ -50,7 +50,5 @@ namespace Pinetime::Applications::Screens {
     lv_obj_t *time, *msecTime, *btnPlayPause, *btnStopLap, *txtPlayPause, *txtStopLap;
     lv_obj_t* lapText;
     bool isHoursLabelUpdated = false;
-
-    lv_task_t* taskRefresh;
   };
 }
@@ -4,6 +4,7 @@
 #include "displayapp/screens/SystemInfo.h"
 #include <lvgl/lvgl.h>
 #include "displayapp/DisplayApp.h"
+#include "displayapp/LittleVgl.h"
 #include "displayapp/screens/Label.h"
 #include "Version.h"
 #include "BootloaderVersion.h"
@@ -11,6 +12,7 @@
 #include "components/ble/BleController.h"
 #include "components/brightness/BrightnessController.h"
 #include "components/datetime/DateTimeController.h"
+#include "components/fs/FS.h"
 #include "components/motion/MotionController.h"
 #include "drivers/Watchdog.h"
 #include "displayapp/InfiniTimeTheme.h"
@@ -38,7 +40,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Controllers::Ble& bleController,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
-                       const Pinetime::Drivers::Cst816S& touchPanel)
+                       const Pinetime::Drivers::Cst816S& touchPanel,
+                       Pinetime::Controllers::FS& filesystem,
+                       const Pinetime::Components::LittleVgl& lvgl)
   : app {app},
     dateTimeController {dateTimeController},
     batteryController {batteryController},
@@ -47,6 +51,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     watchdog {watchdog},
     motionController {motionController},
     touchPanel {touchPanel},
+    filesystem {filesystem},
+    lvgl {lvgl},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -63,6 +69,12 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen7();
               }},
              Screens::ScreenListModes::UpDown} {
 }
@@ -95,7 +107,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, 7, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -174,7 +186,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, 7, label);
 }
 
 extern int mallocFailedCount;
@@ -207,14 +219,100 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         mallocFailedCount,
                         stackOverflowCount);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, 7, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
+  const auto& stats = filesystem.GetStatistics();
+  lfs_ssize_t usedBlocks = filesystem.GetFSSize();
+  auto average = [](const Pinetime::Controllers::FS::OperationStatistics& operation) -> uint32_t {
+    return operation.count == 0 ? 0 : operation.totalLatencyMs / operation.count;
+  };
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#808080 Filesystem#\n"
+                        " #808080 Blocks# %ld/%u\n"
+                        " #808080 Mount# %lums%s\n"
+                        "#808080 Count avg/max ms#\n"
+                        " #808080 Open# %lu %lu/%lu\n"
+                        " #808080 Read# %lu %lu/%lu\n"
+                        " #808080 Write# %lu %lu/%lu\n"
+                        " #808080 Erase# %lu %lu/%lu\n"
+                        "#808080 Prog/%lu erases#\n"
+                        " %luKB (%lu)",
+                        usedBlocks < 0 ? 0 : usedBlocks,
+                        static_cast<unsigned int>(Pinetime::Controllers::FS::getBlockCount()),
+                        stats.mountDurationMs,
+                        stats.formatted ? " fmt" : "",
+                        stats.open.count,
+                        average(stats.open),
+                        stats.open.maxLatencyMs,
+                        stats.read.count,
+                        average(stats.read),
+                        stats.read.maxLatencyMs,
+                        stats.write.count,
+                        average(stats.write),
+                        stats.write.maxLatencyMs,
+                        stats.erase.count,
+                        average(stats.erase),
+                        stats.erase.maxLatencyMs,
+                        static_cast<uint32_t>(Pinetime::Controllers::FS::blockCycles),
+                        stats.lastWindowBytesProgrammed / 1024,
+                        stats.windows);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(3, 7, label);
+}
+
+// Counters of the display and flash optimisations
+std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+  const auto& frames = lvgl.GetFrameStatistics();
+  const uint32_t frameCount = frames.frames == 0 ? 1 : frames.frames;
+  const auto& flushes = lvgl.GetFlushStatistics();
+  const uint32_t flushCount = flushes.flushes == 0 ? 1 : flushes.flushes;
+  const auto& cache = filesystem.GetReadCacheStatistics();
+  const uint32_t cacheReads = cache.hits + cache.misses == 0 ? 1 : cache.hits + cache.misses;
+  const auto& erases = filesystem.GetEraseStatistics();
+  const uint32_t eraseCount = erases.erases == 0 ? 1 : erases.erases;
+  using FlashPowerStates = Pinetime::Drivers::SpiNorFlash::PowerStates;
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#808080 Display#\n"
+                        " #808080 Render# %lu/%lums\n"
+                        " #808080 Px/draws# %lu/%lu\n"
+                        " #808080 Flush wait# %lu/%lums\n"
+                        " #808080 On/dimmed# %lu/%lus\n"
+                        "#808080 Flash#\n"
+                        " #808080 Cache hits# %lu%%\n"
+                        " #808080 Write amp.# %lu%%\n"
+                        " #808080 Erase# %lu/%lums\n"
+                        " #808080 On/DPD# %lu/%lus",
+                        frames.totalRenderTimeMs / frameCount,
+                        frames.maxRenderTimeMs,
+                        frames.totalFlushedPixels / frameCount,
+                        frames.totalDrawBufferCalls / frameCount,
+                        flushes.totalFlushLatencyMs / flushCount,
+                        flushes.maxFlushLatencyMs,
+                        app->GetTicksInPowerState(DisplayApp::PowerStates::Active) / configTICK_RATE_HZ,
+                        app->GetTicksInPowerState(DisplayApp::PowerStates::Dimmed) / configTICK_RATE_HZ,
+                        cache.hits * 100 / cacheReads,
+                        filesystem.GetWriteAmplificationPercent(),
+                        erases.totalLatencyMs / eraseCount,
+                        erases.maxLatencyMs,
+                        filesystem.GetFlashTicksInPowerState(FlashPowerStates::Standby) / configTICK_RATE_HZ,
+                        filesystem.GetFlashTicksInPowerState(FlashPowerStates::DeepPowerDown) / configTICK_RATE_HZ);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(4, 7, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
   return lhs.xTaskNumber < rhs.xTaskNumber;
 }
 
-std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
   static constexpr uint8_t maxTaskCount = 9;
   TaskStatus_t tasksStatus[maxTaskCount];
 
@@ -268,10 +366,10 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(5, 7, infoTask);
 }
 
-std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+std::unique_ptr<Screen> SystemInfo::CreateScreen7() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -285,5 +383,5 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(6, 7, label);
 }
@@ -1,4 +1,5 @@
 #include "displayapp/screens/WatchFaceAnalog.h"
+#include <algorithm>
 #include <cmath>
 #include <lvgl/lvgl.h>
 #include "displayapp/screens/BatteryIcon.h"
@@ -41,6 +42,19 @@ namespace {
                        .y = CoordinateYRelocate(radius * static_cast<int32_t>(Cosine(angle)) / LV_TRIG_SCALE)};
   }
 
+  // Move the line object to the bounding box of the hand, with points relative to it.
+  // A line object starts at the top left corner of its parent and extends to its furthest point, so a line placed at
+  // the origin covers most of the screen and moving it invalidates all of that area. Placed at the bounding box of the
+  // hand, only the areas covered by the old and new positions of the hand are redrawn.
+  void SetHandPoints(lv_obj_t* line, lv_point_t* points, lv_point_t start, lv_point_t end) {
+    lv_coord_t x = std::min(start.x, end.x);
+    lv_coord_t y = std::min(start.y, end.y);
+    points[0] = {static_cast<lv_coord_t>(start.x - x), static_cast<lv_coord_t>(start.y - y)};
+    points[1] = {static_cast<lv_coord_t>(end.x - x), static_cast<lv_coord_t>(end.y - y)};
+    lv_line_set_points(line, points, 2);
+    lv_obj_set_pos(line, x, y);
+  }
+
 }
 
 WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
@@ -124,14 +138,12 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   lv_style_set_line_rounded(&hour_line_style_trace, LV_STATE_DEFAULT, false);
   lv_obj_add_style(hour_body_trace, LV_LINE_PART_MAIN, &hour_line_style_trace);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  SubscribeRefresh(RefreshEvents::Second | RefreshEvents::Battery | RefreshEvents::Ble | RefreshEvents::Notifications);
 
   Refresh();
 }
 
 WatchFaceAnalog::~WatchFaceAnalog() {
-  lv_task_del(taskRefresh);
-
   lv_style_reset(&hour_line_style);
   lv_style_reset(&hour_line_style_trace);
   lv_style_reset(&minute_line_style);
@@ -148,14 +160,8 @@ void WatchFaceAnalog::UpdateClock() {
 
   if (sMinute != minute) {
     auto const angle = minute * 6;
-    minute_point[0] = CoordinateRelocate(30, angle);
-    minute_point[1] = CoordinateRelocate(MinuteLength, angle);
-
-    minute_point_trace[0] = CoordinateRelocate(5, angle);
-    minute_point_trace[1] = CoordinateRelocate(31, angle);
-
-    lv_line_set_points(minute_body, minute_point, 2);
-    lv_line_set_points(minute_body_trace, minute_point_trace, 2);
+    SetHandPoints(minute_body, minute_point, CoordinateRelocate(30, angle), CoordinateRelocate(MinuteLength, angle));
+    SetHandPoints(minute_body_trace, minute_point_trace, CoordinateRelocate(5, angle), CoordinateRelocate(31, angle));
   }
 
   if (sHour != hour || sMinute != minute) {
@@ -163,23 +169,15 @@ void WatchFaceAnalog::UpdateClock() {
     sMinute = minute;
     auto const angle = (hour * 30 + minute / 2);
 
-    hour_point[0] = CoordinateRelocate(30, angle);
-    hour_point[1] = CoordinateRelocate(HourLength, angle);
-
-    hour_point_trace[0] = CoordinateRelocate(5, angle);
-    hour_point_trace[1] = CoordinateRelocate(31, angle);
-
-    lv_line_set_points(hour_body, hour_point, 2);
-    lv_line_set_points(hour_body_trace, hour_point_trace, 2);
+    SetHandPoints(hour_body, hour_point, CoordinateRelocate(30, angle), CoordinateRelocate(HourLength, angle));
+    SetHandPoints(hour_body_trace, hour_point_trace, CoordinateRelocate(5, angle), CoordinateRelocate(31, angle));
   }
 
   if (sSecond != second) {
     sSecond = second;
     auto const angle = second * 6;
 
-    second_point[0] = CoordinateRelocate(-20, angle);
-    second_point[1] = CoordinateRelocate(SecondLength, angle);
-    lv_line_set_points(second_body, second_point, 2);
+    SetHandPoints(second_body, second_point, CoordinateRelocate(-20, angle), CoordinateRelocate(SecondLength, angle));
   }
 }
 
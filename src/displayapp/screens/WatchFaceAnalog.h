@@ -79,8 +79,6 @@ namespace Pinetime {
 
         void UpdateClock();
         void SetBatteryIcon();
-
-        lv_task_t* taskRefresh;
       };
     }
   }
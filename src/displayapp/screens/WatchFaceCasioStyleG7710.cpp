@@ -30,23 +30,14 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
     notificatioManager {notificatioManager},
     settingsController {settingsController},
     heartRateController {heartRateController},
-    motionController {motionController} {
+    motionController {motionController},
+    pagedDot40 {filesystem},
+    pagedSegment40 {filesystem},
+    pagedSegment115 {filesystem} {
 
-  lfs_file f = {};
-  if (filesystem.FileOpen(&f, "/fonts/lv_font_dots_40.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_dot40 = lv_font_load("F:/fonts/lv_font_dots_40.bin");
-  }
-
-  if (filesystem.FileOpen(&f, "/fonts/7segments_40.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_segment40 = lv_font_load("F:/fonts/7segments_40.bin");
-  }
-
-  if (filesystem.FileOpen(&f, "/fonts/7segments_115.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_segment115 = lv_font_load("F:/fonts/7segments_115.bin");
-  }
+  font_dot40 = pagedDot40.Load("/fonts/lv_font_dots_40.bin", 16);
+  font_segment40 = pagedSegment40.Load("/fonts/7segments_40.bin", 12);
+  font_segment115 = pagedSegment115.Load("/fonts/7segments_115.bin", 6);
 
   label_battery_vallue = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_align(label_battery_vallue, lv_scr_act(), LV_ALIGN_IN_TOP_RIGHT, 0, 0);
@@ -168,28 +159,15 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
   lv_label_set_text_static(stepIcon, Symbols::shoe);
   lv_obj_align(stepIcon, stepValue, LV_ALIGN_OUT_LEFT_MID, -5, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  SubscribeRefresh(RefreshEvents::Minute | RefreshEvents::Battery | RefreshEvents::Ble | RefreshEvents::HeartRate | RefreshEvents::Motion |
+                   RefreshEvents::Notifications);
   Refresh();
 }
 
 WatchFaceCasioStyleG7710::~WatchFaceCasioStyleG7710() {
-  lv_task_del(taskRefresh);
-
   lv_style_reset(&style_line);
   lv_style_reset(&style_border);
 
-  if (font_dot40 != nullptr) {
-    lv_font_free(font_dot40);
-  }
-
-  if (font_segment40 != nullptr) {
-    lv_font_free(font_segment40);
-  }
-
-  if (font_segment115 != nullptr) {
-    lv_font_free(font_segment115);
-  }
-
   lv_obj_clean(lv_scr_act());
 }
 
@@ -313,22 +291,6 @@ void WatchFaceCasioStyleG7710::Refresh() {
 }
 
 bool WatchFaceCasioStyleG7710::IsAvailable(Pinetime::Controllers::FS& filesystem) {
-  lfs_file file = {};
-
-  if (filesystem.FileOpen(&file, "/fonts/lv_font_dots_40.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/7segments_40.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/7segments_115.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  return true;
+  return filesystem.IsResourceAvailable("/fonts/lv_font_dots_40.bin") && filesystem.IsResourceAvailable("/fonts/7segments_40.bin") &&
+         filesystem.IsResourceAvailable("/fonts/7segments_115.bin");
 }
@@ -68,12 +68,12 @@ WatchFaceDigital::WatchFaceDigital(Controllers::DateTime& dateTimeController,
   lv_label_set_text_static(stepIcon, Symbols::shoe);
   lv_obj_align(stepIcon, stepValue, LV_ALIGN_OUT_LEFT_MID, -5, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  SubscribeRefresh(RefreshEvents::Minute | RefreshEvents::Battery | RefreshEvents::Ble | RefreshEvents::HeartRate | RefreshEvents::Motion |
+                   RefreshEvents::Notifications);
   Refresh();
 }
 
 WatchFaceDigital::~WatchFaceDigital() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
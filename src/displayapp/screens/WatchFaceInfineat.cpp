@@ -132,17 +132,12 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
     bleController {bleController},
     notificationManager {notificationManager},
     settingsController {settingsController},
-    motionController {motionController} {
-  lfs_file f = {};
-  if (filesystem.FileOpen(&f, "/fonts/teko.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_teko = lv_font_load("F:/fonts/teko.bin");
-  }
-
-  if (filesystem.FileOpen(&f, "/fonts/bebas.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_bebas = lv_font_load("F:/fonts/bebas.bin");
-  }
+    motionController {motionController},
+    pagedTeko {filesystem},
+    pagedBebas {filesystem} {
+  // Glyphs are read from the filesystem when they are drawn, only the glyphs of the current screen are kept in memory
+  font_teko = pagedTeko.Load("/fonts/teko.bin", 16);
+  font_bebas = pagedBebas.Load("/fonts/bebas.bin", 6);
 
   // Side Cover
   static constexpr lv_point_t linePoints[nLines][2] = {{{30, 25}, {68, -8}},
@@ -303,13 +298,6 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
 WatchFaceInfineat::~WatchFaceInfineat() {
   lv_task_del(taskRefresh);
 
-  if (font_bebas != nullptr) {
-    lv_font_free(font_bebas);
-  }
-  if (font_teko != nullptr) {
-    lv_font_free(font_teko);
-  }
-
   lv_obj_clean(lv_scr_act());
 }
 
@@ -487,22 +475,10 @@ void WatchFaceInfineat::ToggleBatteryIndicatorColor(bool showSideCover) {
 }
 
 bool WatchFaceInfineat::IsAvailable(Pinetime::Controllers::FS& filesystem) {
-  lfs_file file = {};
-
-  if (filesystem.FileOpen(&file, "/fonts/teko.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/bebas.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/images/pine_small.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
+  return filesystem.IsResourceAvailable("/fonts/teko.bin") && filesystem.IsResourceAvailable("/fonts/bebas.bin") &&
+         filesystem.IsResourceAvailable("/images/pine_small.bin");
+}
 
-  filesystem.FileClose(&file);
-  return true;
+void WatchFaceInfineat::PrefetchImages(Pinetime::Components::ImageCache& imageCache) {
+  imageCache.Prefetch("/images/pine_small.bin");
 }
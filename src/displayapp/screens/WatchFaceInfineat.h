@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <memory>
 #include "displayapp/screens/Screen.h"
+#include "displayapp/PagedFont.h"
+#include "displayapp/ImageCache.h"
 #include "components/datetime/DateTimeController.h"
 #include "utility/DirtyValue.h"
 
@@ -41,6 +43,7 @@ namespace Pinetime {
         void Refresh() override;
 
         static bool IsAvailable(Pinetime::Controllers::FS& filesystem);
+        static void PrefetchImages(Pinetime::Components::ImageCache& imageCache);
 
       private:
         uint32_t savedTick = 0;
@@ -94,6 +97,8 @@ namespace Pinetime {
         void ToggleBatteryIndicatorColor(bool showSideCover);
 
         lv_task_t* taskRefresh;
+        Components::PagedFont pagedTeko;
+        Components::PagedFont pagedBebas;
         lv_font_t* font_teko = nullptr;
         lv_font_t* font_bebas = nullptr;
       };
@@ -62,12 +62,12 @@ WatchFaceTerminal::WatchFaceTerminal(Controllers::DateTime& dateTimeController,
   lv_label_set_recolor(stepValue, true);
   lv_obj_align(stepValue, lv_scr_act(), LV_ALIGN_IN_LEFT_MID, 0, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  SubscribeRefresh(RefreshEvents::Second | RefreshEvents::Battery | RefreshEvents::Ble | RefreshEvents::HeartRate | RefreshEvents::Motion |
+                   RefreshEvents::Notifications);
   Refresh();
 }
 
 WatchFaceTerminal::~WatchFaceTerminal() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
@@ -64,8 +64,6 @@ namespace Pinetime {
         Controllers::Settings& settingsController;
         Controllers::HeartRateController& heartRateController;
         Controllers::MotionController& motionController;
-
-        lv_task_t* taskRefresh;
       };
     }
   }
@@ -17,6 +17,10 @@ bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
   return spiMaster.Read(pinCsn, cmd, cmdSize, data, dataSize);
 }
 
+bool Spi::ReadRegions(const SpiMaster::ReadRegion* regions, size_t count) {
+  return spiMaster.ReadRegions(pinCsn, regions, count);
+}
+
 void Spi::Sleep() {
   nrf_gpio_cfg_default(pinCsn);
   NRF_LOG_INFO("[SPI] Sleep")
@@ -26,6 +30,14 @@ bool Spi::WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* d
   return spiMaster.WriteCmdAndBuffer(pinCsn, cmd, cmdSize, data, dataSize);
 }
 
+bool Spi::WriteSegments(uint8_t pinDataCommand, const SpiMaster::Segment* segments, size_t count) {
+  return spiMaster.WriteSegments(pinCsn, pinDataCommand, segments, count);
+}
+
+void Spi::WaitForTransfer() {
+  spiMaster.WaitForTransfer();
+}
+
 bool Spi::Init() {
   nrf_gpio_pin_set(pinCsn); /* disable Set slave select (inactive high) */
   return true;
@@ -16,7 +16,10 @@ namespace Pinetime {
       bool Init();
       bool Write(const uint8_t* data, size_t size);
       bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      bool ReadRegions(const SpiMaster::ReadRegion* regions, size_t count);
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      bool WriteSegments(uint8_t pinDataCommand, const SpiMaster::Segment* segments, size_t count);
+      void WaitForTransfer();
       void Sleep();
       void Wakeup();
 
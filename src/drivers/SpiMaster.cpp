@@ -135,6 +135,10 @@ void SpiMaster::OnEndEvent() {
     currentBufferSize -= currentSize;
 
     spiBaseAddress->TASKS_START = 1;
+  } else if (remainingSegments > 0) {
+    remainingSegments--;
+    currentSegment++;
+    StartSegment(*currentSegment);
   } else {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     if (taskToNotify != nullptr) {
@@ -144,6 +148,7 @@ void SpiMaster::OnEndEvent() {
 
     nrf_gpio_pin_set(this->pinCsn);
     currentBufferAddr = 0;
+    currentSegment = nullptr;
     BaseType_t xHigherPriorityTaskWoken2 = pdFALSE;
     xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken2);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken | xHigherPriorityTaskWoken2);
@@ -173,6 +178,23 @@ void SpiMaster::PrepareRx(const volatile uint32_t bufferAddress, const volatile
   spiBaseAddress->EVENTS_END = 0;
 }
 
+void SpiMaster::StartSegment(const Segment& segment) {
+  if (segment.isCommand) {
+    nrf_gpio_pin_clear(pinDataCommand);
+  } else {
+    nrf_gpio_pin_set(pinDataCommand);
+  }
+
+  currentBufferAddr = (uint32_t) segment.data;
+  currentBufferSize = segment.size;
+
+  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
+  PrepareTx(currentBufferAddr, currentSize);
+  currentBufferSize -= currentSize;
+  currentBufferAddr += currentSize;
+  spiBaseAddress->TASKS_START = 1;
+}
+
 bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
   if (data == nullptr)
     return false;
@@ -211,6 +233,11 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
 }
 
 bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
+  ReadRegion region {cmd, cmdSize, data, dataSize};
+  return ReadRegions(pinCsn, &region, 1);
+}
+
+bool SpiMaster::ReadRegions(uint8_t pinCsn, const ReadRegion* regions, size_t count) {
   xSemaphoreTake(mutex, portMAX_DELAY);
 
   taskToNotify = nullptr;
@@ -221,22 +248,33 @@ bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data
   spiBaseAddress->INTENCLR = (1 << 1);
   spiBaseAddress->INTENCLR = (1 << 19);
 
-  nrf_gpio_pin_clear(this->pinCsn);
-
   currentBufferAddr = 0;
   currentBufferSize = 0;
 
-  PrepareTx((uint32_t) cmd, cmdSize);
-  spiBaseAddress->TASKS_START = 1;
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
+  for (size_t i = 0; i < count; i++) {
+    const ReadRegion& region = regions[i];
+    nrf_gpio_pin_clear(this->pinCsn);
 
-  PrepareRx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
+    PrepareTx((uint32_t) region.cmd, region.cmdSize);
+    spiBaseAddress->TASKS_START = 1;
+    while (spiBaseAddress->EVENTS_END == 0)
+      ;
 
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-  nrf_gpio_pin_set(this->pinCsn);
+    // EasyDMA transfers are limited to 255 bytes, the chip select stays asserted between them
+    uint32_t address = (uint32_t) region.data;
+    size_t remaining = region.dataSize;
+    do {
+      auto currentSize = std::min((size_t) 255, remaining);
+      PrepareRx(address, currentSize);
+      spiBaseAddress->TASKS_START = 1;
+      while (spiBaseAddress->EVENTS_END == 0)
+        ;
+      address += currentSize;
+      remaining -= currentSize;
+    } while (remaining > 0);
+
+    nrf_gpio_pin_set(this->pinCsn);
+  }
 
   xSemaphoreGive(mutex);
 
@@ -291,3 +329,39 @@ bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmd
 
   return true;
 }
+
+bool SpiMaster::WriteSegments(uint8_t pinCsn, uint8_t pinDataCommand, const Segment* segments, size_t count) {
+  if (segments == nullptr || count == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (segments[i].data == nullptr || segments[i].size == 0) {
+      return false;
+    }
+  }
+
+  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
+  ASSERT(ok == true);
+  taskToNotify = xTaskGetCurrentTaskHandle();
+
+  this->pinCsn = pinCsn;
+  this->pinDataCommand = pinDataCommand;
+
+  // The whole list is sent from the END interrupt, the caller is notified once when the last segment is sent.
+  // FTPAN-58 only affects transfers with RXD.MAXCNT = 1, so single byte command segments do not need the workaround.
+  DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+
+  nrf_gpio_pin_clear(this->pinCsn);
+
+  currentSegment = segments;
+  remainingSegments = count - 1;
+  StartSegment(*currentSegment);
+
+  return true;
+}
+
+void SpiMaster::WaitForTransfer() {
+  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
+  ASSERT(ok == true);
+  xSemaphoreGive(mutex);
+}
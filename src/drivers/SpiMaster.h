@@ -24,6 +24,23 @@ namespace Pinetime {
         uint8_t pinMISO;
       };
 
+      // One element of a chained write. The data/command pin is cleared while a command segment is sent
+      // and set while a data segment is sent. The data must stay valid until the end of the transfer.
+      struct Segment {
+        const uint8_t* data;
+        size_t size;
+        bool isCommand;
+      };
+
+      // One read of a batch: the command is sent, then the data is received, with the chip select asserted.
+      // The data can be larger than a single EasyDMA transfer.
+      struct ReadRegion {
+        const uint8_t* cmd;
+        size_t cmdSize;
+        uint8_t* data;
+        size_t dataSize;
+      };
+
       SpiMaster(const SpiModule spi, const Parameters& params);
       SpiMaster(const SpiMaster&) = delete;
       SpiMaster& operator=(const SpiMaster&) = delete;
@@ -33,8 +50,13 @@ namespace Pinetime {
       bool Init();
       bool Write(uint8_t pinCsn, const uint8_t* data, size_t size);
       bool Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      // Perform the reads one after the other without releasing the bus in between
+      bool ReadRegions(uint8_t pinCsn, const ReadRegion* regions, size_t count);
 
       bool WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      bool WriteSegments(uint8_t pinCsn, uint8_t pinDataCommand, const Segment* segments, size_t count);
+      // Block until the transfer in progress, if any, has ended and released the bus
+      void WaitForTransfer();
 
       void OnStartedEvent();
       void OnEndEvent();
@@ -47,6 +69,7 @@ namespace Pinetime {
       void DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
       void PrepareRx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void StartSegment(const Segment& segment);
 
       NRF_SPIM_Type* spiBaseAddress;
       uint8_t pinCsn;
@@ -56,6 +79,9 @@ namespace Pinetime {
 
       volatile uint32_t currentBufferAddr = 0;
       volatile size_t currentBufferSize = 0;
+      const Segment* volatile currentSegment = nullptr;
+      volatile size_t remainingSegments = 0;
+      uint8_t pinDataCommand;
       volatile TaskHandle_t taskToNotify;
       SemaphoreHandle_t mutex = nullptr;
     };
@@ -10,19 +10,55 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+  }
+  if (idleTimer == nullptr) {
+    idleTimer = xTimerCreate("flashIdle", 1, pdFALSE, this, IdleTimerCallback);
+  }
   device_id = ReadIdentificaion();
+  DetectCapabilities();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
                device_id.type,
                device_id.density);
 }
 
+void SpiNorFlash::DetectCapabilities() {
+  // Manufacturers of the memories fitted to the PineTime and its variants, which all implement Fast Read.
+  // Macronix memories use other opcodes to suspend and resume an erase.
+  // The ID reads as 0x00 or 0xff while the memory is in deep power down.
+  switch (device_id.manufacturer) {
+    case 0x0B: // XTX
+    case 0x20: // XMC
+    case 0x68: // Boya
+    case 0x85: // Puya
+    case 0xC8: // GigaDevice
+    case 0xEF: // Winbond
+      isFastReadSupported = true;
+      isEraseSuspendSupported = true;
+      break;
+    case 0xC2: // Macronix
+      isFastReadSupported = true;
+      isEraseSuspendSupported = false;
+      break;
+    default:
+      isFastReadSupported = false;
+      isEraseSuspendSupported = false;
+      break;
+  }
+}
+
 void SpiNorFlash::Uninit() {
 }
 
 void SpiNorFlash::Sleep() {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  xTimerStop(idleTimer, 0);
   auto cmd = static_cast<uint8_t>(Commands::DeepPowerDown);
   spi.Write(&cmd, sizeof(uint8_t));
+  SetPowerState(PowerStates::DeepPowerDown);
+  xSemaphoreGive(mutex);
   NRF_LOG_INFO("[SpiNorFlash] Sleep")
 }
 
@@ -31,8 +67,12 @@ void SpiNorFlash::Wakeup() {
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::ReleaseFromDeepPowerDown), 0x01, 0x02, 0x03};
   uint8_t id = 0;
+  xSemaphoreTake(mutex, portMAX_DELAY);
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, &id, 1);
   auto devId = device_id = ReadIdentificaion();
+  DetectCapabilities();
+  SetPowerState(PowerStates::Standby);
+  Release();
   if (devId.type != device_id.type) {
     NRF_LOG_INFO("[SpiNorFlash] ID on Wakeup: Failed");
   } else {
@@ -70,13 +110,42 @@ uint8_t SpiNorFlash::ReadConfigurationRegister() {
   return status;
 }
 
+size_t SpiNorFlash::PrepareReadCommand(uint8_t* cmd, uint32_t address) const {
+  cmd[0] = static_cast<uint8_t>(isFastReadSupported ? Commands::FastRead : Commands::Read);
+  cmd[1] = static_cast<uint8_t>(address >> 16U);
+  cmd[2] = static_cast<uint8_t>(address >> 8U);
+  cmd[3] = static_cast<uint8_t>(address);
+  if (isFastReadSupported) {
+    // Dummy byte
+    cmd[4] = 0;
+    return 5;
+  }
+  return 4;
+}
+
 void SpiNorFlash::Read(uint32_t address, uint8_t* buffer, size_t size) {
-  static constexpr uint8_t cmdSize = 4;
-  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::Read),
-                          static_cast<uint8_t>(address >> 16U),
-                          static_cast<uint8_t>(address >> 8U),
-                          static_cast<uint8_t>(address)};
-  spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+  uint8_t cmd[maxReadCmdSize];
+  size_t cmdSize = PrepareReadCommand(cmd, address);
+  BeginRead();
+  spi.Read(cmd, cmdSize, buffer, size);
+  EndRead();
+}
+
+void SpiNorFlash::ReadRegions(const ReadRegion* regions, size_t count) {
+  uint8_t cmds[maxBatchRegions][maxReadCmdSize];
+  SpiMaster::ReadRegion batch[maxBatchRegions];
+  while (count > 0) {
+    size_t batchSize = (count < maxBatchRegions) ? count : maxBatchRegions;
+    for (size_t i = 0; i < batchSize; i++) {
+      size_t cmdSize = PrepareReadCommand(cmds[i], regions[i].address);
+      batch[i] = {cmds[i], cmdSize, regions[i].buffer, regions[i].size};
+    }
+    BeginRead();
+    spi.ReadRegions(batch, batchSize);
+    EndRead();
+    regions += batchSize;
+    count -= batchSize;
+  }
 }
 
 void SpiNorFlash::WriteEnable() {
@@ -85,20 +154,182 @@ void SpiNorFlash::WriteEnable() {
 }
 
 void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
+  StartSectorErase(sectorAddress);
+  WaitEraseDone();
+}
+
+void SpiNorFlash::StartSectorErase(uint32_t sectorAddress) {
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::SectorErase),
                           static_cast<uint8_t>(sectorAddress >> 16U),
                           static_cast<uint8_t>(sectorAddress >> 8U),
                           static_cast<uint8_t>(sectorAddress)};
 
+  AcquireIdle();
   WriteEnable();
   while (!WriteEnabled())
     vTaskDelay(1);
 
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, nullptr, 0);
+  eraseStart = xTaskGetTickCount();
+  isEraseInProgress = true;
+  Release();
+}
+
+// Record the end of the erase in progress once the memory is not busy anymore, with the mutex taken
+bool SpiNorFlash::UpdateEraseStatus() {
+  if (isEraseInProgress && !WriteInProgress()) {
+    isEraseInProgress = false;
+    uint32_t latencyMs = (xTaskGetTickCount() - eraseStart) * 1000 / configTICK_RATE_HZ;
+    eraseStatistics.erases++;
+    eraseStatistics.lastLatencyMs = latencyMs;
+    eraseStatistics.totalLatencyMs += latencyMs;
+    if (latencyMs > eraseStatistics.maxLatencyMs) {
+      eraseStatistics.maxLatencyMs = latencyMs;
+    }
+  }
+  return !isEraseInProgress;
+}
+
+bool SpiNorFlash::IsEraseDone() {
+  Acquire();
+  bool done = UpdateEraseStatus();
+  Release();
+  return done;
+}
+
+void SpiNorFlash::WaitEraseDone() {
+  while (!IsEraseDone())
+    vTaskDelay(1);
+}
+
+void SpiNorFlash::SendCommand(Commands command) {
+  auto cmd = static_cast<uint8_t>(command);
+  spi.Read(&cmd, sizeof(cmd), nullptr, 0);
+}
+
+// Take the memory for a command sequence, waking it up from deep power down
+void SpiNorFlash::Acquire() {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if (powerState == PowerStates::DeepPowerDown) {
+    SendCommand(Commands::ReleaseFromDeepPowerDown);
+    nrf_delay_us(releaseFromDeepPowerDownUs);
+    SetPowerState(PowerStates::Standby);
+    powerStatistics.accessWakeups++;
+  }
+}
 
-  while (WriteInProgress())
+// Take the memory for a program or an erase, once the erase started by another task has ended. The mutex is kept
+// from the check to the command, so that no erase can start in between.
+void SpiNorFlash::AcquireIdle() {
+  Acquire();
+  while (!UpdateEraseStatus()) {
+    xSemaphoreGive(mutex);
     vTaskDelay(1);
+    Acquire();
+  }
+}
+
+// The timer is only started when it is not running: the accesses made while it runs only record their time, which
+// the timer checks when it expires, instead of waking up the timer task to restart it after each of them
+void SpiNorFlash::Release() {
+  lastAccess = xTaskGetTickCount();
+  if (idlePowerDownDelay > 0 && xTimerIsTimerActive(idleTimer) == pdFALSE) {
+    xTimerChangePeriod(idleTimer, idlePowerDownDelay, 0);
+  }
+  xSemaphoreGive(mutex);
+}
+
+void SpiNorFlash::SetIdlePowerDownDelay(TickType_t delay) {
+  idlePowerDownDelay = delay;
+  if (delay > 0) {
+    xTimerChangePeriod(idleTimer, delay, 0);
+  } else {
+    xTimerStop(idleTimer, 0);
+  }
+}
+
+void SpiNorFlash::IdleTimerCallback(TimerHandle_t timer) {
+  static_cast<SpiNorFlash*>(pvTimerGetTimerID(timer))->PowerDownIfIdle();
+}
+
+void SpiNorFlash::PowerDownIfIdle() {
+  // Do not block the timer task: the task using the memory restarts the timer when it is done.
+  // While an erase is in progress, the access which sees its end restarts it too.
+  if (xSemaphoreTake(mutex, 0) != pdTRUE) {
+    return;
+  }
+  if (!isEraseInProgress && idlePowerDownDelay > 0) {
+    TickType_t idleTicks = xTaskGetTickCount() - lastAccess;
+    if (idleTicks < idlePowerDownDelay) {
+      xTimerChangePeriod(idleTimer, idlePowerDownDelay - idleTicks, 0);
+    } else if (powerState == PowerStates::Standby) {
+      SendCommand(Commands::DeepPowerDown);
+      SetPowerState(PowerStates::DeepPowerDown);
+      powerStatistics.idlePowerDowns++;
+    }
+  }
+  xSemaphoreGive(mutex);
+}
+
+void SpiNorFlash::SetPowerState(PowerStates state) {
+  TickType_t now = xTaskGetTickCount();
+  powerStatistics.ticksInState[static_cast<uint8_t>(powerState)] += now - powerStateStart;
+  powerStateStart = now;
+  powerState = state;
+}
+
+TickType_t SpiNorFlash::GetTicksInPowerState(PowerStates state) const {
+  TickType_t ticks = powerStatistics.ticksInState[static_cast<uint8_t>(state)];
+  if (state == powerState) {
+    ticks += xTaskGetTickCount() - powerStateStart;
+  }
+  return ticks;
+}
+
+// Reads return garbage while the memory is busy: suspend the erase in progress, or wait for its end
+void SpiNorFlash::BeginRead() {
+  Acquire();
+  if (!isEraseInProgress || !WriteInProgress()) {
+    return;
+  }
+
+  if (isEraseSuspendSupported) {
+    // The tick counter does not measure microseconds: less than 2 ticks since the resume can be anything from 0 to 2ms
+    if (xTaskGetTickCount() - lastResumeTick < 2) {
+      nrf_delay_us(resumeToSuspendUs);
+    }
+    SendCommand(Commands::EraseSuspend);
+    // Resumed by EndRead() even if the suspend takes longer than expected
+    isEraseSuspended = true;
+    eraseStatistics.suspends++;
+    uint32_t waitedUs = 0;
+    while (WriteInProgress()) {
+      if (waitedUs < maxSuspendLatencyUs) {
+        nrf_delay_us(1);
+        waitedUs++;
+      } else {
+        vTaskDelay(1);
+      }
+    }
+    return;
+  }
+
+  eraseStatistics.waits++;
+  do {
+    xSemaphoreGive(mutex);
+    vTaskDelay(1);
+    xSemaphoreTake(mutex, portMAX_DELAY);
+  } while (isEraseInProgress && WriteInProgress());
+}
+
+void SpiNorFlash::EndRead() {
+  if (isEraseSuspended) {
+    SendCommand(Commands::EraseResume);
+    isEraseSuspended = false;
+    lastResumeTick = xTaskGetTickCount();
+  }
+  Release();
 }
 
 uint8_t SpiNorFlash::ReadSecurityRegister() {
@@ -131,6 +362,8 @@ void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
                             static_cast<uint8_t>(addr >> 8U),
                             static_cast<uint8_t>(addr)};
 
+    // Reads from other tasks wait for the end of the program
+    AcquireIdle();
     WriteEnable();
     while (!WriteEnabled())
       vTaskDelay(1);
@@ -139,6 +372,7 @@ void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
 
     while (WriteInProgress())
       vTaskDelay(1);
+    Release();
 
     addr += toWrite;
     b += toWrite;
@@ -1,6 +1,9 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <timers.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -20,14 +23,50 @@ namespace Pinetime {
         uint8_t density = 0;
       };
 
+      // A read of a batch, see ReadRegions()
+      struct ReadRegion {
+        uint32_t address;
+        uint8_t* buffer;
+        size_t size;
+      };
+
+      struct EraseStatistics {
+        uint32_t erases = 0;
+        // Time from the erase command to the erase being seen done, in ms
+        uint32_t lastLatencyMs = 0;
+        uint32_t maxLatencyMs = 0;
+        uint32_t totalLatencyMs = 0;
+        // Reads served by suspending an erase, and reads which had to wait for the end of an erase
+        uint32_t suspends = 0;
+        uint32_t waits = 0;
+      };
+
+      // Deep power down is entered by Sleep(), or automatically once the memory has been idle for the delay set by
+      // SetIdlePowerDownDelay(). Any command sequence wakes the memory up first.
+      enum class PowerStates : uint8_t { Standby, DeepPowerDown };
+      static constexpr uint8_t nbPowerStates = 2;
+
+      struct PowerStatistics {
+        // Indexed by PowerStates. The time spent in the current state is added when it is left, see GetTicksInPowerState().
+        TickType_t ticksInState[nbPowerStates] = {};
+        // Automatic transitions, Sleep() and Wakeup() are not counted
+        uint32_t idlePowerDowns = 0;
+        uint32_t accessWakeups = 0;
+      };
+
       Identification ReadIdentificaion();
       uint8_t ReadStatusRegister();
       bool WriteInProgress();
       bool WriteEnabled();
       uint8_t ReadConfigurationRegister();
       void Read(uint32_t address, uint8_t* buffer, size_t size);
+      // Read several regions without releasing the SPI bus between them, saving the mutex and task switches of
+      // separate Read() calls. The reads are sent in batches of maxBatchRegions.
+      void ReadRegions(const ReadRegion* regions, size_t count);
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
       void WriteEnable();
+      // Erase the sector and wait for the end of the erase. The bus is free during the erase: reads from other tasks
+      // suspend the erase if the memory supports it, or wait for its end otherwise.
       void SectorErase(uint32_t sectorAddress);
       uint8_t ReadSecurityRegister();
       bool ProgramFailed();
@@ -39,23 +78,94 @@ namespace Pinetime {
       void Sleep();
       void Wakeup();
 
+      // Enter deep power down after delay ticks without access, 0 disables the automatic power down.
+      // Only enable it if the bootloader can initialize the memory in deep power down: the watch may reset at any time.
+      void SetIdlePowerDownDelay(TickType_t delay);
+
+      PowerStates GetPowerState() const {
+        return powerState;
+      }
+
+      const PowerStatistics& GetPowerStatistics() const {
+        return powerStatistics;
+      }
+
+      // Time spent in the state, including the time spent so far if it is the current state
+      TickType_t GetTicksInPowerState(PowerStates state) const;
+
+      bool IsFastReadSupported() const {
+        return isFastReadSupported;
+      }
+
+      const EraseStatistics& GetEraseStatistics() const {
+        return eraseStatistics;
+      }
+
+      static constexpr size_t maxBatchRegions = 8;
+
     private:
       enum class Commands : uint8_t {
         PageProgram = 0x02,
         Read = 0x03,
+        FastRead = 0x0B,
         ReadStatusRegister = 0x05,
         WriteEnable = 0x06,
         ReadConfigurationRegister = 0x15,
         SectorErase = 0x20,
         ReadSecurityRegister = 0x2B,
+        EraseSuspend = 0x75,
+        EraseResume = 0x7A,
         ReadIdentification = 0x9F,
         ReleaseFromDeepPowerDown = 0xAB,
         DeepPowerDown = 0xB9
       };
       static constexpr uint16_t pageSize = 256;
+      // Command, 24 bits address and the dummy byte of Fast Read
+      static constexpr size_t maxReadCmdSize = 5;
+      // Time for the memory to accept commands after ReleaseFromDeepPowerDown (tRES1), longest of the supported memories
+      static constexpr uint32_t releaseFromDeepPowerDownUs = 30;
+      // Minimum time between an erase resume and the next suspend (tRS), so that back to back reads do not keep the
+      // erase from progressing
+      static constexpr uint32_t resumeToSuspendUs = 100;
+      // Time after which a suspend which has not completed yet (tSUS) yields to the other tasks while it is polled
+      static constexpr uint32_t maxSuspendLatencyUs = 50;
+
+      static void IdleTimerCallback(TimerHandle_t timer);
+
+      void DetectCapabilities();
+      size_t PrepareReadCommand(uint8_t* cmd, uint32_t address) const;
+      void SendCommand(Commands command);
+      void Acquire();
+      void AcquireIdle();
+      void Release();
+      void PowerDownIfIdle();
+      void SetPowerState(PowerStates state);
+      void BeginRead();
+      void EndRead();
+      void StartSectorErase(uint32_t sectorAddress);
+      bool UpdateEraseStatus();
+      bool IsEraseDone();
+      void WaitEraseDone();
 
       Spi& spi;
       Identification device_id;
+      bool isFastReadSupported = false;
+      bool isEraseSuspendSupported = false;
+
+      // Serializes the command sequences of the tasks using the memory, so that a read can suspend an erase
+      SemaphoreHandle_t mutex = nullptr;
+      volatile bool isEraseInProgress = false;
+      bool isEraseSuspended = false;
+      TickType_t lastResumeTick = 0;
+      TickType_t eraseStart = 0;
+      EraseStatistics eraseStatistics;
+
+      TimerHandle_t idleTimer = nullptr;
+      TickType_t lastAccess = 0;
+      TickType_t idlePowerDownDelay = 0;
+      PowerStates powerState = PowerStates::Standby;
+      TickType_t powerStateStart = 0;
+      PowerStatistics powerStatistics;
     };
   }
 }
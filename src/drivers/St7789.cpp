@@ -31,11 +31,13 @@ void St7789::Init() {
 }
 
 void St7789::WriteCommand(uint8_t cmd) {
+  spi.WaitForTransfer();
   nrf_gpio_pin_clear(pinDataCommand);
   WriteSpi(&cmd, 1);
 }
 
 void St7789::WriteData(uint8_t data) {
+  spi.WaitForTransfer();
   nrf_gpio_pin_set(pinDataCommand);
   WriteSpi(&data, 1);
 }
@@ -105,28 +107,66 @@ void St7789::NormalModeOn() {
   nrf_delay_ms(10);
 }
 
+void St7789::PartialModeOn() {
+  WriteCommand(static_cast<uint8_t>(Commands::PartialModeOn));
+}
+
+void St7789::PartialAreaDefinition(uint16_t startLine, uint16_t endLine) {
+  WriteCommand(static_cast<uint8_t>(Commands::PartialAreaDefinition));
+  WriteData(startLine >> 8u);
+  WriteData(startLine & 0x00ffu);
+  WriteData(endLine >> 8u);
+  WriteData(endLine & 0x00ffu);
+}
+
+void St7789::IdleModeOn() {
+  WriteCommand(static_cast<uint8_t>(Commands::IdleModeOn));
+}
+
+void St7789::IdleModeOff() {
+  WriteCommand(static_cast<uint8_t>(Commands::IdleModeOff));
+}
+
 void St7789::DisplayOn() {
   WriteCommand(static_cast<uint8_t>(Commands::DisplayOn));
 }
 
-void St7789::SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet));
-  WriteData(x0 >> 8);
-  WriteData(x0 & 0xff);
-  WriteData(x1 >> 8);
-  WriteData(x1 & 0xff);
-
-  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet));
-  WriteData(y0 >> 8);
-  WriteData(y0 & 0xff);
-  WriteData(y1 >> 8);
-  WriteData(y1 & 0xff);
+void St7789::WriteWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* data, size_t size) {
+  spi.WaitForTransfer();
+  SetWindowSegments(0, x0, y0, x1, y1, data, size);
+  WriteWindowSegments(1);
+}
 
-  WriteToRam();
+void St7789::WriteWindowSegments(size_t nbWindows) {
+  size_t first = scrollSegments;
+  if (isScrollQueued) {
+    first = 0;
+    isScrollQueued = false;
+  }
+  spi.WriteSegments(pinDataCommand, &segments[first], (scrollSegments - first) + nbWindows * segmentsPerWindow);
 }
 
-void St7789::WriteToRam() {
-  WriteCommand(static_cast<uint8_t>(Commands::WriteToRam));
+void St7789::SetWindowSegments(size_t index, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* data, size_t size) {
+  uint8_t* commands = windowCommands[index];
+  commands[0] = static_cast<uint8_t>(Commands::ColumnAddressSet);
+  commands[1] = x0 >> 8;
+  commands[2] = x0 & 0xff;
+  commands[3] = x1 >> 8;
+  commands[4] = x1 & 0xff;
+  commands[5] = static_cast<uint8_t>(Commands::RowAddressSet);
+  commands[6] = y0 >> 8;
+  commands[7] = y0 & 0xff;
+  commands[8] = y1 >> 8;
+  commands[9] = y1 & 0xff;
+  commands[10] = static_cast<uint8_t>(Commands::WriteToRam);
+
+  SpiMaster::Segment* window = &segments[scrollSegments + index * segmentsPerWindow];
+  window[0] = {&commands[0], 1, true};
+  window[1] = {&commands[1], 4, false};
+  window[2] = {&commands[5], 1, true};
+  window[3] = {&commands[6], 4, false};
+  window[4] = {&commands[10], 1, true};
+  window[5] = {data, size, false};
 }
 
 void St7789::SetVdv() {
@@ -153,11 +193,23 @@ void St7789::VerticalScrollDefinition(uint16_t topFixedLines, uint16_t scrollLin
 
 void St7789::VerticalScrollStartAddress(uint16_t line) {
   verticalScrollingStartAddress = line;
+  isScrollQueued = false;
   WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollStartAddress));
   WriteData(line >> 8u);
   WriteData(line & 0x00ffu);
 }
 
+void St7789::QueueVerticalScrollStartAddress(uint16_t line) {
+  spi.WaitForTransfer();
+  verticalScrollingStartAddress = line;
+  scrollCommand[0] = static_cast<uint8_t>(Commands::VerticalScrollStartAddress);
+  scrollCommand[1] = line >> 8u;
+  scrollCommand[2] = line & 0x00ffu;
+  segments[0] = {&scrollCommand[0], 1, true};
+  segments[1] = {&scrollCommand[1], 2, false};
+  isScrollQueued = true;
+}
+
 void St7789::Uninit() {
 }
 
@@ -166,16 +218,32 @@ void St7789::DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
     return;
   }
 
-  SetAddrWindow(x, y, x + 1, y + 1);
-
-  nrf_gpio_pin_set(pinDataCommand);
-  WriteSpi(reinterpret_cast<const uint8_t*>(&color), 2);
+  spi.WaitForTransfer();
+  pixel[0] = color & 0xff;
+  pixel[1] = (color >> 8) & 0xff;
+  WriteWindow(x, y, x + 1, y + 1, pixel, 2);
 }
 
 void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
-  SetAddrWindow(x, y, x + width - 1, y + height - 1);
-  nrf_gpio_pin_set(pinDataCommand);
-  WriteSpi(data, size);
+  WriteWindow(x, y, x + width - 1, y + height - 1, data, size);
+}
+
+void St7789::DrawBufferToWindows(const Window* windows, size_t count, const uint8_t* data) {
+  if (count == 0 || count > maxWindows) {
+    return;
+  }
+  spi.WaitForTransfer();
+  for (size_t i = 0; i < count; i++) {
+    const Window& window = windows[i];
+    SetWindowSegments(i,
+                      window.x,
+                      window.y,
+                      window.x + window.width - 1,
+                      window.y + window.height - 1,
+                      data,
+                      window.width * window.height * 2);
+  }
+  WriteWindowSegments(count);
 }
 
 void St7789::HardwareReset() {
@@ -197,3 +265,18 @@ void St7789::Wakeup() {
   DisplayOn();
   NRF_LOG_INFO("[LCD] Wakeup")
 }
+
+void St7789::LowPowerOn(uint16_t firstLine, uint16_t lastLine) {
+  // The partial area is defined in display RAM lines, which are offset by the vertical scrolling.
+  // The area wraps around the end of the RAM when the end line is lower than the start line.
+  PartialAreaDefinition((firstLine + verticalScrollingStartAddress) % Height, (lastLine + verticalScrollingStartAddress) % Height);
+  PartialModeOn();
+  IdleModeOn();
+  NRF_LOG_INFO("[LCD] Low power mode on");
+}
+
+void St7789::LowPowerOff() {
+  IdleModeOff();
+  NormalModeOn();
+  NRF_LOG_INFO("[LCD] Low power mode off");
+}
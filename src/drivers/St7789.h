@@ -1,6 +1,7 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include "drivers/SpiMaster.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -8,6 +9,16 @@ namespace Pinetime {
 
     class St7789 {
     public:
+      struct Window {
+        uint16_t x;
+        uint16_t y;
+        uint16_t width;
+        uint16_t height;
+      };
+
+      // Maximum number of windows written by DrawBufferToWindows()
+      static constexpr size_t maxWindows = 4;
+
       explicit St7789(Spi& spi, uint8_t pinDataCommand);
       St7789(const St7789&) = delete;
       St7789& operator=(const St7789&) = delete;
@@ -20,16 +31,27 @@ namespace Pinetime {
 
       void VerticalScrollDefinition(uint16_t topFixedLines, uint16_t scrollLines, uint16_t bottomFixedLines);
       void VerticalScrollStartAddress(uint16_t line);
+      // Send the vertical scroll start address at the beginning of the next DrawBuffer() transfer instead of in its own
+      // transfers: scrolling and drawing the lines it exposes are chained in a single transfer.
+      void QueueVerticalScrollStartAddress(uint16_t line);
 
       void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+      // Write the beginning of data to each window, in a single chained transfer. Used to draw several areas of
+      // the same colour: data must hold at least the pixels of the largest window.
+      void DrawBufferToWindows(const Window* windows, size_t count, const uint8_t* data);
 
       void Sleep();
       void Wakeup();
 
+      // Low power mode: only the visible lines firstLine to lastLine (inclusive) are driven, in 8 colours (idle mode).
+      // The rest of the panel is off. The display RAM is retained and can still be written in this mode.
+      void LowPowerOn(uint16_t firstLine, uint16_t lastLine);
+      void LowPowerOff();
+
     private:
       Spi& spi;
       uint8_t pinDataCommand;
-      uint8_t verticalScrollingStartAddress = 0;
+      uint16_t verticalScrollingStartAddress = 0;
 
       void HardwareReset();
       void SoftwareReset();
@@ -39,11 +61,16 @@ namespace Pinetime {
       void MemoryDataAccessControl();
       void DisplayInversionOn();
       void NormalModeOn();
-      void WriteToRam();
+      void PartialModeOn();
+      void PartialAreaDefinition(uint16_t startLine, uint16_t endLine);
+      void IdleModeOn();
+      void IdleModeOff();
       void DisplayOn();
       void DisplayOff();
 
-      void SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+      void WriteWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* data, size_t size);
+      void SetWindowSegments(size_t index, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* data, size_t size);
+      void WriteWindowSegments(size_t nbWindows);
       void SetVdv();
       void WriteCommand(uint8_t cmd);
       void WriteSpi(const uint8_t* data, size_t size);
@@ -52,6 +79,7 @@ namespace Pinetime {
         SoftwareReset = 0x01,
         SleepIn = 0x10,
         SleepOut = 0x11,
+        PartialModeOn = 0x12,
         NormalModeOn = 0x13,
         DisplayInversionOn = 0x21,
         DisplayOff = 0x28,
@@ -59,9 +87,12 @@ namespace Pinetime {
         ColumnAddressSet = 0x2a,
         RowAddressSet = 0x2b,
         WriteToRam = 0x2c,
+        PartialAreaDefinition = 0x30,
         MemoryDataAccessControl = 0x36,
         VerticalScrollDefinition = 0x33,
         VerticalScrollStartAddress = 0x37,
+        IdleModeOff = 0x38,
+        IdleModeOn = 0x39,
         ColMod = 0x3a,
         VdvSet = 0xc4,
       };
@@ -71,6 +102,18 @@ namespace Pinetime {
       static constexpr uint16_t Width = 240;
       static constexpr uint16_t Height = 320;
       void RowAddressSet();
+
+      // CASET, RASET and RAMWR commands with their parameters, sent ahead of the pixel data in a single
+      // chained transfer. They are kept in RAM as EasyDMA cannot read from flash.
+      // The segments of a queued VSCSAD command precede the segments of the windows.
+      // These buffers and the DC pin are read by the transfer in progress: wait for it before changing them.
+      static constexpr size_t segmentsPerWindow = 6;
+      static constexpr size_t scrollSegments = 2;
+      uint8_t windowCommands[maxWindows][11];
+      uint8_t scrollCommand[3];
+      uint8_t pixel[2];
+      SpiMaster::Segment segments[scrollSegments + maxWindows * segmentsPerWindow];
+      bool isScrollQueued = false;
     };
   }
 }
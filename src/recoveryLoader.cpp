@@ -31,6 +31,7 @@ Pinetime::Logging::DummyLogger logger;
 static constexpr uint8_t displayWidth = 240;
 static constexpr uint8_t displayHeight = 240;
 static constexpr uint8_t bytesPerPixel = 2;
+static constexpr uint8_t stripLines = 4;
 
 static constexpr uint16_t colorWhite = 0xFFFF;
 static constexpr uint16_t colorGreen = 0xE007;
@@ -80,7 +81,8 @@ void RefreshWatchdog() {
   NRF_WDT->RR[0] = WDT_RR_RR_Reload;
 }
 
-uint8_t displayBuffer[displayWidth * bytesPerPixel];
+uint8_t displayBuffer[displayWidth * bytesPerPixel * stripLines];
+uint8_t secondDisplayBuffer[displayWidth * bytesPerPixel * stripLines];
 
 void Process(void* /*instance*/) {
   RefreshWatchdog();
@@ -94,6 +96,9 @@ void Process(void* /*instance*/) {
   lcd.Init();
   gfx.Init();
 
+  // Send a dummy notification to unlock the display driver for the first transfer
+  xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+
   NRF_LOG_INFO("Display logo")
   DisplayLogo();
 
@@ -122,11 +127,7 @@ void Process(void* /*instance*/) {
 
 void DisplayLogo() {
   Pinetime::Tools::RleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb));
-  for (int i = 0; i < displayWidth; i++) {
-    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
-    ulTaskNotifyTake(pdTRUE, 500);
-    lcd.DrawBuffer(0, i, displayWidth, 1, reinterpret_cast<const uint8_t*>(displayBuffer), displayWidth * bytesPerPixel);
-  }
+  rleDecoder.DecodeToDisplay(lcd, displayWidth, displayHeight, displayBuffer, secondDisplayBuffer, sizeof(displayBuffer));
 }
 
 void DisplayProgressBar(uint8_t percent, uint16_t color) {
@@ -25,6 +25,9 @@ def gen_lvconv_line(lv_font_conv: str, dest: str, size: int, bpp: int, format: s
     args = [lv_font_conv, '--size', str(size), '--output', dest, '--bpp', str(bpp), '--format', format]
     if not compress:
         args.append('--no-compress')
+    if format == "bin":
+        # PagedFont does not read the kerning table
+        args.append('--no-kerning')
     for source in sources:
         args.extend(['--font', source.file])
         if source.range:
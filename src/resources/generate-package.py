@@ -3,18 +3,52 @@
 import io
 import sys
 import json
+import zlib
 import shutil
+import struct
 import typing
 import os.path
 import argparse
 import subprocess
 from zipfile import ZipFile
 
+PACK_NAME = 'resources.pak'
+PACK_VERSION = 1
+
+def fnv1a(path):
+    """Id of an asset in the resource pack, same as ResourcePack::Id(): hash of the path with a single leading '/'"""
+    value = 2166136261
+    for byte in ('/' + path.lstrip('/')).encode('utf-8'):
+        value = ((value ^ byte) * 16777619) & 0xffffffff
+    return value
+
+def write_pack(pack_path, assets):
+    """Write the resource pack read by Controllers::ResourcePack, assets is a list of (target path, local file)"""
+    index = []
+    data = bytearray()
+    for target_path, local_path in assets:
+        with open(local_path, 'rb') as fd:
+            content = fd.read()
+        data += b'\0' * (-len(data) % 4)
+        index.append((fnv1a(target_path), len(data), len(content), target_path))
+        data += content
+
+    index.sort()
+    for previous, current in zip(index, index[1:]):
+        if previous[0] == current[0]:
+            sys.exit(f'Error: {previous[3]} and {current[3]} have the same id in the resource pack.')
+
+    index_data = b''.join(struct.pack('<III', asset_id, offset, size) for asset_id, offset, size, _ in index)
+    header = struct.pack('<4sHHII', b'IRPK', PACK_VERSION, len(index), zlib.crc32(index_data), len(data))
+    with open(pack_path, 'wb') as fd:
+        fd.write(header + index_data + data)
+
 def main():
     ap = argparse.ArgumentParser(description='auto generate LVGL font files from fonts')
     ap.add_argument('--config', '-c', type=str, action='append', help='config file to use')
     ap.add_argument('--obsolete', type=str, help='List of obsolete files')
     ap.add_argument('--output', type=str, help='output file name')
+    ap.add_argument('--pack', action='store_true', help='install the resources as a single pack (' + PACK_NAME + ') instead of separate files')
     args = ap.parse_args()
 
     for config_file in args.config:
@@ -32,6 +66,7 @@ def main():
 
     zf = ZipFile(args.output, mode='w')
     resource_files = []
+    pack_assets = []
 
     for config_file in args.config:
         with open(config_file, 'r') as fd:
@@ -40,15 +75,27 @@ def main():
         resource_names = set(data.keys())
         for name in resource_names:
             resource = data[name]
-            resource_files.append({
-                "filename": name+'.bin',
-                "path": resource['target_path'] + name+'.bin'
-            })
+            if not args.pack:
+                resource_files.append({
+                    "filename": name+'.bin',
+                    "path": resource['target_path'] + name+'.bin'
+                })
 
             path = name + '.bin'
             if not os.path.exists(path):
                 path = os.path.join(os.path.dirname(sys.argv[0]), path)
-            zf.write(path)
+            if not args.pack:
+                zf.write(path)
+            pack_assets.append((resource['target_path'] + name + '.bin', path))
+
+    # The pack replaces the separate files, installing both would store every resource twice
+    if args.pack:
+        write_pack(PACK_NAME, pack_assets)
+        resource_files.append({
+            "filename": PACK_NAME,
+            "path": "/" + PACK_NAME
+        })
+        zf.write(PACK_NAME)
 
     if args.obsolete:
         obsolete_file_path = os.path.join(os.path.dirname(sys.argv[0]), args.obsolete)
@@ -5,6 +5,7 @@
 #include "BootloaderVersion.h"
 #include "components/battery/BatteryController.h"
 #include "components/ble/BleController.h"
+#include "components/heartrate/HeartRateController.h"
 #include "displayapp/TouchEvents.h"
 #include "drivers/Cst816s.h"
 #include "drivers/St7789.h"
@@ -107,8 +108,15 @@ void SystemTask::Work() {
   spi.Init();
   spiNorFlash.Init();
   spiNorFlash.Wakeup();
+  // Same restriction as the deep power down of the flash during sleep, see Messages::OnDisplayTaskSleeping
+  if (BootloaderVersion::IsValid()) {
+    spiNorFlash.SetIdlePowerDownDelay(flashIdlePowerDownDelay);
+  }
 
   fs.Init();
+  stepsHistory.Init();
+  heartRateHistory.Init();
+  batteryHistory.Init();
 
   nimbleController.Init();
 
@@ -179,6 +187,7 @@ void SystemTask::Work() {
 #pragma ide diagnostic ignored "EndlessLoop"
   while (true) {
     UpdateMotion();
+    UpdateHeartRateHistory();
 
     Messages msg;
     if (xQueueReceive(systemTasksMsgQueue, &msg, 100) == pdTRUE) {
@@ -195,14 +204,19 @@ void SystemTask::Work() {
           doNotGoToSleep = true;
           break;
         case Messages::GoToRunning:
-          spi.Wakeup();
+          // The SPI bus and the flash are kept awake in always on mode
+          if (!settingsController.GetAlwaysOnDisplay()) {
+            spi.Wakeup();
+          }
 
           // Double Tap needs the touch screen to be in normal mode
           if (!settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::DoubleTap)) {
             touchPanel.Wakeup();
           }
 
-          spiNorFlash.Wakeup();
+          if (!settingsController.GetAlwaysOnDisplay()) {
+            spiNorFlash.Wakeup();
+          }
 
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::GoToRunning);
           heartRateApp.PushMessage(Pinetime::Applications::HeartRateTask::Messages::WakeUp);
@@ -273,6 +287,7 @@ void SystemTask::Work() {
           break;
         case Messages::BleFirmwareUpdateFinished:
           if (bleController.State() == Pinetime::Controllers::Ble::FirmwareUpdateStates::Validated) {
+            FlushPendingWrites();
             NVIC_SystemReset();
           }
           doNotGoToSleep = false;
@@ -315,12 +330,17 @@ void SystemTask::Work() {
           HandleButtonAction(action);
         } break;
         case Messages::OnDisplayTaskSleeping:
-          if (BootloaderVersion::IsValid()) {
-            // First versions of the bootloader do not expose their version and cannot initialize the SPI NOR FLASH
-            // if it's in sleep mode. Avoid bricked device by disabling sleep mode on these versions.
-            spiNorFlash.Sleep();
+          // Write the history and the settings while the flash is awake, they are not lost if the watch resets during the sleep
+          FlushPendingWrites();
+          // In always on mode, the display task still refreshes the screen (and may load resources from the flash)
+          if (!settingsController.GetAlwaysOnDisplay()) {
+            if (BootloaderVersion::IsValid()) {
+              // First versions of the bootloader do not expose their version and cannot initialize the SPI NOR FLASH
+              // if it's in sleep mode. Avoid bricked device by disabling sleep mode on these versions.
+              spiNorFlash.Sleep();
+            }
+            spi.Sleep();
           }
-          spi.Sleep();
 
           // Double Tap needs the touch screen to be in normal mode
           if (!settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::DoubleTap)) {
@@ -365,9 +385,17 @@ void SystemTask::Work() {
           break;
         case Messages::MeasureBatteryTimerExpired:
           batteryController.MeasureVoltage();
+          stepsHistory.Append(HistoryTimestamp(), motionController.NbSteps());
+          if (stepsHistory.IsFull()) {
+            FlushPendingWrites();
+          }
           break;
         case Messages::BatteryPercentageUpdated:
           nimbleController.NotifyBatteryLevel(batteryController.PercentRemaining());
+          batteryHistory.Append(HistoryTimestamp(), batteryController.PercentRemaining());
+          if (batteryHistory.IsFull()) {
+            FlushPendingWrites();
+          }
           break;
         case Messages::OnPairing:
           if (state == SystemTaskState::Sleeping) {
@@ -438,6 +466,42 @@ void SystemTask::UpdateMotion() {
   }
 }
 
+void SystemTask::UpdateHeartRateHistory() {
+  if (heartRateController.State() != Controllers::HeartRateController::States::Running || heartRateController.HeartRate() == 0) {
+    return;
+  }
+  uint32_t timestamp = HistoryTimestamp();
+  if (timestamp - lastHeartRateSample >= heartRateHistoryPeriodSeconds) {
+    heartRateHistory.Append(timestamp, heartRateController.HeartRate());
+    lastHeartRateSample = timestamp;
+    if (heartRateHistory.IsFull()) {
+      FlushPendingWrites();
+    }
+  }
+}
+
+void SystemTask::FlushPendingWrites() {
+  // The SPI bus is disabled during the sleep, except in always on mode. The flash wakes up on the first access.
+  bool isBusAsleep = state == SystemTaskState::Sleeping && !settingsController.GetAlwaysOnDisplay();
+  if (isBusAsleep) {
+    spi.Wakeup();
+  }
+  stepsHistory.Flush();
+  heartRateHistory.Flush();
+  batteryHistory.Flush();
+  settingsController.Flush();
+  if (isBusAsleep) {
+    if (BootloaderVersion::IsValid()) {
+      spiNorFlash.Sleep();
+    }
+    spi.Sleep();
+  }
+}
+
+uint32_t SystemTask::HistoryTimestamp() const {
+  return std::chrono::duration_cast<std::chrono::seconds>(dateTimeController.CurrentDateTime().time_since_epoch()).count();
+}
+
 void SystemTask::HandleButtonAction(Controllers::ButtonActions action) {
   if (IsSleeping()) {
     return;
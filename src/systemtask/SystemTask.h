@@ -17,6 +17,7 @@
 #include "components/ble/NotificationManager.h"
 #include "components/alarm/AlarmController.h"
 #include "components/fs/FS.h"
+#include "components/fs/TimeSeriesLog.h"
 #include "touchhandler/TouchHandler.h"
 #include "buttonhandler/ButtonHandler.h"
 #include "buttonhandler/ButtonActions.h"
@@ -122,6 +123,12 @@ namespace Pinetime {
       Pinetime::Controllers::ButtonHandler& buttonHandler;
       Pinetime::Controllers::NimbleController nimbleController;
 
+      // History of the steps, heart rate and battery readings, kept across reboots
+      Pinetime::Controllers::TimeSeriesLog stepsHistory {fs, "/history/steps", Controllers::TimeSeriesLog::Aggregation::Last};
+      Pinetime::Controllers::TimeSeriesLog heartRateHistory {fs, "/history/hr", Controllers::TimeSeriesLog::Aggregation::Average};
+      Pinetime::Controllers::TimeSeriesLog batteryHistory {fs, "/history/battery", Controllers::TimeSeriesLog::Aggregation::Average};
+      uint32_t lastHeartRateSample = 0;
+
       static void Process(void* instance);
       void Work();
       bool isBleDiscoveryTimerRunning = false;
@@ -135,8 +142,14 @@ namespace Pinetime {
 
       void GoToRunning();
       void UpdateMotion();
+      void UpdateHeartRateHistory();
+      void FlushPendingWrites();
+      uint32_t HistoryTimestamp() const;
       bool stepCounterMustBeReset = false;
       static constexpr TickType_t batteryMeasurementPeriod = pdMS_TO_TICKS(10 * 60 * 1000);
+      // Idle time after which the external flash enters deep power down while the watch is running
+      static constexpr TickType_t flashIdlePowerDownDelay = pdMS_TO_TICKS(100);
+      static constexpr uint32_t heartRateHistoryPeriodSeconds = 10;
 
       SystemMonitor monitor;
     };
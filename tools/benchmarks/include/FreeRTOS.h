@@ -0,0 +1,10 @@
+#pragma once
+// Host stand-in for the FreeRTOS definitions used by the benchmarked sources
+
+#include <cstdint>
+
+using TickType_t = uint32_t;
+using BaseType_t = long;
+
+#define pdFALSE 0
+#define pdTRUE 1
@@ -0,0 +1,20 @@
+#pragma once
+// Host stand-in for the display driver: DrawBuffer() copies the pixels to a frame buffer in RAM
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Drivers {
+    class St7789 {
+    public:
+      static constexpr uint16_t Width = 240;
+      static constexpr uint16_t Height = 240;
+
+      void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+
+      uint8_t frame[Width * Height * 2];
+      uint32_t drawBufferCalls = 0;
+    };
+  }
+}
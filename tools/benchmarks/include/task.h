@@ -0,0 +1,5 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// Defined by each benchmark, transfers end immediately on the host
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
@@ -0,0 +1,119 @@
+/* Host benchmark of the blend kernel of Rgb565.h against the software rendering of lvgl v7 that it replaces (the
+ * lv_color_mix() loop of map_normal() in lv_draw_blend.c, transcribed below for 16 bit swapped colors).
+ * Each run blends a 240x240 image over the screen, line by line like lvgl does.
+ *
+ * From the root of the repository:
+ *   g++ -std=c++14 -O2 -Isrc tools/benchmarks/rgb565.cpp -o /tmp/rgb565
+ *   /tmp/rgb565
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include "displayapp/Rgb565.h"
+
+using namespace Pinetime::Components;
+
+namespace {
+  constexpr int width = 240;
+  constexpr int height = 240;
+  constexpr int iterations = 2000;
+
+  // lv_color_mix() of lv_color.h with LV_COLOR_16_SWAP: green is split in two 3 bit fields around red and blue
+  uint16_t LvglMix(uint16_t c1, uint16_t c2, uint8_t mix) {
+    auto red = [](uint16_t c) -> uint32_t {
+      return (c >> 3) & 0x1f;
+    };
+    auto blue = [](uint16_t c) -> uint32_t {
+      return (c >> 8) & 0x1f;
+    };
+    auto green = [](uint16_t c) -> uint32_t {
+      return ((c & 0x7) << 3) | ((c >> 13) & 0x7);
+    };
+    auto div255 = [](uint32_t x) -> uint32_t {
+      return (x * 0x8081) >> 0x17;
+    };
+    uint32_t r = div255(red(c1) * mix + red(c2) * (255 - mix) + 128);
+    uint32_t g = div255(green(c1) * mix + green(c2) * (255 - mix) + 128);
+    uint32_t b = div255(blue(c1) * mix + blue(c2) * (255 - mix) + 128);
+    return static_cast<uint16_t>((g >> 3) | (r << 3) | (b << 8) | ((g & 0x7) << 13));
+  }
+
+  void LvglBlend(uint16_t* dest, const uint16_t* src, uint32_t length, uint8_t opa) {
+    if (opa > 250) {
+      std::memcpy(dest, src, length * sizeof(uint16_t));
+      return;
+    }
+    for (uint32_t x = 0; x < length; x++) {
+      dest[x] = LvglMix(src[x], dest[x], opa);
+    }
+  }
+
+  uint16_t screen[width * height];
+  uint16_t image[width * height];
+  volatile uint16_t sink;
+
+  template <typename Function>
+  double Measure(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      function(i);
+      sink = screen[i % (width * height)];
+    }
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(elapsedUs) / iterations;
+  }
+
+  void Report(const char* name, double lvglUs, double kernelUs) {
+    std::printf("%-26s lvgl %7.1f us  kernel %7.1f us  x%.2f\n", name, lvglUs, kernelUs, lvglUs / kernelUs);
+  }
+
+  void CompareBlend(const char* name, uint8_t opa) {
+    double lvglUs = Measure([opa](int) {
+      for (int y = 0; y < height; y++) {
+        LvglBlend(&screen[y * width], &image[y * width], width, opa);
+      }
+    });
+    double kernelUs = Measure([opa](int) {
+      for (int y = 0; y < height; y++) {
+        Rgb565::BlendPixels(&screen[y * width], &image[y * width], width, opa);
+      }
+    });
+    Report(name, lvglUs, kernelUs);
+  }
+}
+
+int main() {
+  std::srand(1);
+  for (int i = 0; i < width * height; i++) {
+    image[i] = static_cast<uint16_t>(std::rand());
+    screen[i] = static_cast<uint16_t>(std::rand());
+  }
+
+  // Largest difference between the two mixes, in levels of a channel, before the benchmark overwrites the screen
+  uint32_t maxError = 0;
+  for (int i = 0; i < width * height; i++) {
+    for (uint8_t opa : {32, 64, 128, 192}) {
+      uint16_t a = LvglMix(image[i], screen[i], opa);
+      uint16_t b = Rgb565::BlendPixel(image[i], screen[i], (opa + 4) >> 3);
+      uint32_t ra = Rgb565::SpreadChannels(Rgb565::SwapBytes(a));
+      uint32_t rb = Rgb565::SpreadChannels(Rgb565::SwapBytes(b));
+      for (uint32_t mask : {0x1fu, 0x7e00000u, 0xf800u}) {
+        uint32_t ca = ra & mask;
+        uint32_t cb = rb & mask;
+        uint32_t lsb = mask & (~mask + 1);
+        uint32_t error = (ca > cb ? ca - cb : cb - ca) / lsb;
+        if (error > maxError) {
+          maxError = error;
+        }
+      }
+    }
+  }
+  std::printf("largest difference from lv_color_mix(): %u level(s) of a channel\n", maxError);
+
+  CompareBlend("blend, opa 128", 128);
+  CompareBlend("blend, opa 64", 64);
+  CompareBlend("blend, opa cover", 255);
+  return 0;
+}
@@ -0,0 +1,61 @@
+/* Host benchmark of RleDecoder::DecodeToDisplay(), drawing the boot logo with strips of different heights.
+ * The display is replaced by a copy to RAM, so this measures the decoding throughput only, without the SPI
+ * transfers which it overlaps on the watch.
+ *
+ * From the root of the repository:
+ *   g++ -std=c++14 -O2 -Itools/benchmarks/include -Isrc tools/benchmarks/rle_decoder.cpp -o /tmp/rle_decoder
+ *   /tmp/rle_decoder
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "components/rle/RleDecoder.cpp"
+#include "displayapp/icons/infinitime/infinitime-nb.c"
+
+using namespace Pinetime;
+
+void Drivers::St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
+  drawBufferCalls++;
+  for (uint16_t line = 0; line < height; line++) {
+    std::memcpy(&frame[((y + line) * Width + x) * 2], &data[line * width * 2], std::min(size, static_cast<size_t>(width * 2)));
+    size -= width * 2;
+  }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t /*xClearCountOnExit*/, TickType_t /*xTicksToWait*/) {
+  return 1;
+}
+
+namespace {
+  constexpr uint16_t width = Drivers::St7789::Width;
+  constexpr uint16_t height = Drivers::St7789::Height;
+  constexpr int iterations = 2000;
+
+  Drivers::St7789 lcd;
+  uint8_t buffer1[width * 2 * 16];
+  uint8_t buffer2[width * 2 * 16];
+
+  void Run(uint8_t stripLines) {
+    lcd.drawBufferCalls = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      Tools::RleDecoder decoder(infinitime_nb, sizeof(infinitime_nb));
+      decoder.DecodeToDisplay(lcd, width, height, buffer1, buffer2, width * 2 * stripLines);
+    }
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    double pixelsPerMs = static_cast<double>(width) * height * iterations / (elapsedUs / 1000.0);
+    std::printf("%2u line strips: %6.1f us/image, %8.0f px/ms, %3u DrawBuffer() per image\n",
+                stripLines,
+                static_cast<double>(elapsedUs) / iterations,
+                pixelsPerMs,
+                lcd.drawBufferCalls / iterations);
+  }
+}
+
+int main() {
+  for (uint8_t stripLines : {1, 4, 8, 16}) {
+    Run(stripLines);
+  }
+  return 0;
+}
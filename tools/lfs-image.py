@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+
+"""Build, inspect and benchmark littlefs images of the external flash, off-target.
+
+The images use the littlefs configuration of Controllers::FS (src/components/fs/FS.cpp) and the layout of the
+4 MB NOR flash documented in FS.h:
+
+    0x000000  Bootloader assets (256 KB)
+    0x040000  OTA (464 KB)
+    0x0B4000  File system (up to 0x400000)
+
+An image is either the file system partition alone, or a full NOR image (4 MB, as programmed at the factory) in
+which the file system starts at 0x0B4000. The type of an existing image is detected from its size.
+
+The flash is emulated with NOR semantics: an erase sets a block to 0xff, a program can only clear bits. Each
+operation is counted and its duration estimated from the SPI clock of the PineTime (8 MHz) and typical program and
+erase times, to compare the mount time, read throughput and fragmentation of resource packs.
+
+Requires littlefs-python (pip install littlefs-python).
+
+Examples:
+    lfs-image.py create resources/ fs.bin --nor
+    lfs-image.py ls fs.bin
+    lfs-image.py extract fs.bin out/
+    lfs-image.py bench fs.bin --read-cache-pages 4
+"""
+
+import os
+import sys
+import mmap
+import argparse
+
+try:
+    from littlefs import LittleFS
+except ImportError:
+    sys.exit('Error: littlefs-python is required (pip install littlefs-python)')
+
+NOR_SIZE = 0x400000
+FS_START_ADDRESS = 0x0B4000
+FS_SIZE = 0x34C000
+BLOCK_SIZE = 4096
+PAGE_SIZE = 256
+
+# Same values as the lfs_config of Controllers::FS
+LFS_CONFIG = {
+    'block_size': BLOCK_SIZE,
+    'block_count': FS_SIZE // BLOCK_SIZE,
+    'read_size': 16,
+    'prog_size': 8,
+    'cache_size': 16,
+    'lookahead_size': 16,
+    'name_max': 50,
+    'block_cycles': 1000,
+}
+
+# Timing model, in microseconds
+SPI_BYTE_US = 1.0          # 8 bits at 8 MHz
+TRANSACTION_US = 20.0      # Bus mutex, chip select and task switches of one SpiMaster transaction
+PAGE_PROGRAM_US = 600.0    # Typical page program time (tPP)
+SECTOR_ERASE_US = 45000.0  # Typical 4 KB sector erase time (tSE)
+READ_CMD_BYTES = 4         # Read (0x03) and a 24 bits address
+
+
+class NorFlash:
+    """Emulates the file system partition of the NOR flash on top of a buffer (bytearray or mmap).
+
+    Implements the block device interface expected by littlefs-python. The reads can go through a model of the
+    FlashReadCache of the firmware (LRU of 256 bytes pages, for reads smaller than a page).
+    """
+
+    def __init__(self, buffer, offset, read_cache_pages=0):
+        self.buffer = buffer
+        self.offset = offset
+        self.read_cache_pages = read_cache_pages
+        self.cached_pages = []
+        self.trace = None
+        self.reset_counters()
+
+    def reset_counters(self):
+        self.reads = 0
+        self.bytes_read = 0
+        self.cache_hits = 0
+        self.programs = 0
+        self.bytes_programmed = 0
+        self.erases = 0
+        self.overwrites = 0
+        self.time_us = 0.0
+
+    def _address(self, cfg, block, off):
+        return self.offset + block * BLOCK_SIZE + off
+
+    def _flash_read(self, address, size):
+        self.reads += 1
+        self.bytes_read += size
+        self.time_us += TRANSACTION_US + (READ_CMD_BYTES + size) * SPI_BYTE_US
+
+    def _cached_read(self, address, size):
+        end = address + size
+        while address < end:
+            page = address - (address % PAGE_SIZE)
+            length = min(end, page + PAGE_SIZE) - address
+            if page in self.cached_pages:
+                self.cache_hits += 1
+                self.cached_pages.remove(page)
+            else:
+                self._flash_read(page, PAGE_SIZE)
+                if len(self.cached_pages) >= self.read_cache_pages:
+                    self.cached_pages.pop(0)
+            self.cached_pages.append(page)
+            address += length
+
+    def read(self, cfg, block, off, size):
+        address = self._address(cfg, block, off)
+        if self.trace is not None:
+            self.trace.append(block)
+        if self.read_cache_pages > 0 and size < PAGE_SIZE:
+            self._cached_read(address, size)
+        else:
+            self._flash_read(address, size)
+        return bytearray(self.buffer[address:address + size])
+
+    def prog(self, cfg, block, off, data):
+        # The programs are costed one by one, the coalescing of FlashWriteBuffer is not modelled
+        address = self._address(cfg, block, off)
+        self.cached_pages = [page for page in self.cached_pages if not address - PAGE_SIZE < page < address + len(data)]
+        for i, value in enumerate(data):
+            current = self.buffer[address + i]
+            if current & value != value:
+                self.overwrites += 1
+            self.buffer[address + i] = current & value
+        self.programs += 1
+        self.bytes_programmed += len(data)
+        # Programs are split at page boundaries, each page costs a write enable and a page program
+        pages = (address + len(data) - 1) // PAGE_SIZE - address // PAGE_SIZE + 1
+        self.time_us += pages * (3 * TRANSACTION_US + PAGE_PROGRAM_US) + (READ_CMD_BYTES + len(data)) * SPI_BYTE_US
+        return 0
+
+    def erase(self, cfg, block):
+        address = self._address(cfg, block, 0)
+        self.cached_pages = [page for page in self.cached_pages if not address <= page < address + BLOCK_SIZE]
+        self.buffer[address:address + BLOCK_SIZE] = b'\xff' * BLOCK_SIZE
+        self.erases += 1
+        self.time_us += 3 * TRANSACTION_US + SECTOR_ERASE_US
+        return 0
+
+    def sync(self, cfg):
+        return 0
+
+    def report(self, label):
+        print(f'{label}: {self.time_us / 1000:.1f} ms, {self.reads} reads ({self.bytes_read} bytes, '
+              f'{self.cache_hits} cache hits), {self.programs} programs ({self.bytes_programmed} bytes), '
+              f'{self.erases} erases, {self.overwrites} programs of non-erased bits')
+
+
+def open_image(path):
+    """Map an existing image, returns the buffer and the offset of the file system"""
+    size = os.path.getsize(path)
+    if size == NOR_SIZE:
+        offset = FS_START_ADDRESS
+    elif size == FS_SIZE:
+        offset = 0
+    else:
+        sys.exit(f'Error: {path} is neither a NOR image ({NOR_SIZE} bytes) nor a file system image ({FS_SIZE} bytes)')
+    with open(path, 'rb') as fd:
+        # Copy on write: the image file is never modified, even if littlefs writes to the emulated flash
+        buffer = mmap.mmap(fd.fileno(), 0, access=mmap.ACCESS_COPY)
+    return buffer, offset
+
+
+def mount(flash):
+    return LittleFS(context=flash, mount=True, **LFS_CONFIG)
+
+
+def walk_files(fs, top='/'):
+    for root, _, files in fs.walk(top):
+        for name in sorted(files):
+            yield root.rstrip('/') + '/' + name
+
+
+def command_create(args):
+    buffer = bytearray(b'\xff' * (NOR_SIZE if args.nor else FS_SIZE))
+    flash = NorFlash(buffer, FS_START_ADDRESS if args.nor else 0)
+    fs = LittleFS(context=flash, mount=False, **LFS_CONFIG)
+    fs.format()
+    fs.mount()
+
+    for root, dirs, files in os.walk(args.source):
+        dirs.sort()
+        relative = os.path.relpath(root, args.source)
+        directory = '/' if relative == '.' else '/' + relative.replace(os.sep, '/')
+        if directory != '/':
+            fs.makedirs(directory, exist_ok=True)
+        for name in sorted(files):
+            destination = directory.rstrip('/') + '/' + name
+            if len(name) > LFS_CONFIG['name_max']:
+                sys.exit(f'Error: the name of {destination} is longer than {LFS_CONFIG["name_max"]} characters')
+            with open(os.path.join(root, name), 'rb') as source, fs.open(destination, 'wb') as target:
+                target.write(source.read())
+            print(f'{destination}')
+
+    flash.report('Write')
+    print(f'{fs.used_block_count} of {LFS_CONFIG["block_count"]} blocks used')
+    fs.unmount()
+    with open(args.output, 'wb') as fd:
+        fd.write(buffer)
+
+
+def command_ls(args):
+    buffer, offset = open_image(args.image)
+    fs = mount(NorFlash(buffer, offset))
+    for root, dirs, files in fs.walk('/'):
+        for name in sorted(files):
+            path = root.rstrip('/') + '/' + name
+            print(f'{fs.stat(path).size:>10}  {path}')
+
+
+def command_extract(args):
+    buffer, offset = open_image(args.image)
+    fs = mount(NorFlash(buffer, offset))
+    for path in walk_files(fs):
+        destination = os.path.join(args.destination, *path.strip('/').split('/'))
+        os.makedirs(os.path.dirname(destination), exist_ok=True)
+        with fs.open(path, 'rb') as source, open(destination, 'wb') as target:
+            target.write(source.read())
+        print(path)
+
+
+def command_bench(args):
+    buffer, offset = open_image(args.image)
+    flash = NorFlash(buffer, offset, args.read_cache_pages)
+
+    fs = mount(flash)
+    flash.report('Mount')
+
+    total_bytes = 0
+    total_us = 0.0
+    for path in walk_files(fs):
+        flash.reset_counters()
+        with fs.open(path, 'rb') as fd:
+            flash.trace = []
+            size = len(fd.read())
+        # Fragmentation: the blocks of the file which do not follow the previous one
+        blocks = flash.trace
+        flash.trace = None
+        fragments = 1 + sum(1 for previous, current in zip(blocks, blocks[1:]) if current not in (previous, previous + 1))
+        throughput = size / flash.time_us * 1e6 / 1024 if flash.time_us > 0 else 0
+        print(f'{path}: {size} bytes in {flash.time_us / 1000:.1f} ms ({throughput:.1f} KB/s), '
+              f'{flash.reads} reads, {fragments} fragments')
+        total_bytes += size
+        total_us += flash.time_us
+
+    if total_us > 0:
+        print(f'Total: {total_bytes} bytes in {total_us / 1000:.1f} ms ({total_bytes / total_us * 1e6 / 1024:.1f} KB/s)')
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Build, inspect and benchmark littlefs images of the PineTime external flash')
+    subparsers = ap.add_subparsers(dest='command', required=True)
+
+    create = subparsers.add_parser('create', help='build an image from the content of a directory')
+    create.add_argument('source', help='directory copied to the root of the file system')
+    create.add_argument('output', help='image file')
+    create.add_argument('--nor', action='store_true', help='output a full 4 MB NOR image instead of the file system partition')
+    create.set_defaults(handler=command_create)
+
+    ls = subparsers.add_parser('ls', help='list the files of an image')
+    ls.add_argument('image')
+    ls.set_defaults(handler=command_ls)
+
+    extract = subparsers.add_parser('extract', help='copy the files of an image to a directory')
+    extract.add_argument('image')
+    extract.add_argument('destination')
+    extract.set_defaults(handler=command_extract)
+
+    bench = subparsers.add_parser('bench', help='estimate the mount time and the read throughput of each file')
+    bench.add_argument('image')
+    bench.add_argument('--read-cache-pages', type=int, default=4,
+                       help='pages of the FlashReadCache model, 0 to read the flash directly (default: 4)')
+    bench.set_defaults(handler=command_bench)
+
+    args = ap.parse_args()
+    args.handler(args)
+
+
+if __name__ == '__main__':
+    main()